@@ -0,0 +1,573 @@
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "tusb.h"
+
+#include "ballistics.h"
+#include "hid_layout.h"
+#include "hid_pool.h"
+#include "hid_reports.h"
+#include "hid_setup.h"
+#include "host_usb.h"
+#include "latency.h"
+#include "msx_buttons.h"
+#include "msx_encode.h"
+#include "msx_host.h"
+#include "msx_joystick.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+#include "output_backend.h"
+#include "mouse_merge.h"
+#include "settings.h"
+#include "trace.h"
+
+// -----------------------------------------------------------------------------
+// Host-Benchmark der Report-Pipeline: ns pro Report bzw. Lesezyklus
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint32_t REPORTS = 1u << 20;
+
+// 16 Tasten, X/Y 12 Bit, Rad 8 Bit, Report-ID 2 (typische 1000-Hz-Maus)
+uint8_t const desc_id12[] = {
+    0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x85, 0x02, 0x09, 0x01, 0xA1, 0x00,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x15, 0x00, 0x25, 0x01, 0x95, 0x10,
+    0x75, 0x01, 0x81, 0x02, 0x05, 0x01, 0x16, 0x01, 0xF8, 0x26, 0xFF, 0x07,
+    0x75, 0x0C, 0x95, 0x02, 0x09, 0x30, 0x09, 0x31, 0x81, 0x06, 0x15, 0x81,
+    0x25, 0x7F, 0x75, 0x08, 0x95, 0x01, 0x09, 0x38, 0x81, 0x06, 0xC0, 0xC0,
+};
+
+// Funk-Empfänger: Tastatur (ID 1) vor der Maus aus desc_id12 (ID 2)
+uint8_t const desc_keyboard_id1[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x85, 0x01, 0x05, 0x07, 0x19, 0xE0,
+    0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x06, 0x75, 0x08, 0x15, 0x00,
+    0x26, 0xFF, 0x00, 0x05, 0x07, 0x19, 0x00, 0x2A, 0xFF, 0x00, 0x81, 0x00,
+    0xC0,
+};
+
+// Boot-kompatible Maus ohne Report-ID: 3 Tasten, X/Y/Rad je 8 Bit
+uint8_t const desc_boot[] = {
+    0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00, 0x05, 0x09,
+    0x19, 0x01, 0x29, 0x03, 0x15, 0x00, 0x25, 0x01, 0x95, 0x03, 0x75, 0x01,
+    0x81, 0x02, 0x95, 0x01, 0x75, 0x05, 0x81, 0x01, 0x05, 0x01, 0x09, 0x30,
+    0x09, 0x31, 0x09, 0x38, 0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x03,
+    0x81, 0x06, 0xC0, 0xC0,
+};
+
+uint32_t rng_state = 12345;
+
+uint32_t rng(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+volatile int32_t sink;
+
+double ns_per(std::chrono::steady_clock::time_point t0, uint32_t n)
+{
+    auto dt = std::chrono::steady_clock::now() - t0;
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / n;
+}
+
+std::vector<uint8_t> make_boot_reports(uint32_t n)
+{
+    std::vector<uint8_t> r(n * 4);
+    for (uint32_t i = 0; i < n; i++) {
+        r[i * 4 + 0] = (uint8_t)(rng() & 0x07);
+        r[i * 4 + 1] = (uint8_t)(rng() % 21 - 10);
+        r[i * 4 + 2] = (uint8_t)(rng() % 21 - 10);
+        r[i * 4 + 3] = 0;
+    }
+    return r;
+}
+
+// -----------------------------------------------------------------------------
+// Dekodierung: bisheriger Cast gegen Extraktionsplan (gleiche Boot-Reports)
+// -----------------------------------------------------------------------------
+void bench_decode(void)
+{
+    std::vector<uint8_t> reports = make_boot_reports(REPORTS);
+    hid_mouse_layout_t parsed;
+    hid_layout_parse(&parsed, nullptr, desc_boot, sizeof(desc_boot));
+
+    int32_t acc = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        hid_mouse_report_t const* m = (hid_mouse_report_t const*)&reports[i * 4];
+        acc += m->buttons + m->x + m->y + m->wheel;
+    }
+    double cast_ns = ns_per(t0, REPORTS);
+    sink = acc;
+
+    acc = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        hid_mouse_sample_t s = {};
+        hid_layout_decode(&parsed, &reports[i * 4], 4, &s);
+        acc += s.buttons + s.x + s.y + s.wheel;
+    }
+    double plan_ns = ns_per(t0, REPORTS);
+    sink = acc;
+
+    printf("decode  cast          %7.2f ns/report\n", cast_ns);
+    printf("decode  plan          %7.2f ns/report\n", plan_ns);
+}
+
+// -----------------------------------------------------------------------------
+// Kompletter Report-Callback (Dekodierung, Ausgabe, Trace)
+// -----------------------------------------------------------------------------
+void bench_callback(char const* name, uint8_t const* desc, uint16_t desc_len,
+                    uint8_t report_id, uint16_t report_len, boot_policy_t policy)
+{
+    hid_setup_set_policy(policy);
+    host_usb_set_device(1, 0x046d, 0xc077);
+    host_usb_set_protocol(1, 0, HID_ITF_PROTOCOL_MOUSE, HID_PROTOCOL_REPORT);
+    tuh_hid_mount_cb(1, 0, desc, desc_len);
+    hid_setup_service();
+    hid_setup_reset_stats();
+    hid_reports_reset_stats();
+
+    std::vector<uint8_t> reports(REPORTS * report_len);
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        uint8_t* r = &reports[i * report_len];
+        for (uint16_t b = 0; b < report_len; b++) r[b] = (uint8_t)rng();
+        if (report_id) r[0] = report_id;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        tuh_hid_report_received_cb(1, 0, &reports[i * report_len], report_len);
+        hid_reports_service();
+    }
+    double ns = ns_per(t0, REPORTS);
+
+    // unbewaffnet: Callback-Eintritt bis zur neuen Anforderung
+    hid_mode_t const mode = hid_setup_mode(hid_pool_find(1, 0));
+    hid_mode_stats_t const m = hid_setup_get_stats().mode[mode];
+    hid_reports_stats_t const r = hid_reports_get_stats();
+    printf("report  %-13s %7.2f ns/report  [%s, %lu counted, unarmed %.1f ns]\n", name, ns,
+           mode == HID_MODE_BOOT ? "boot" : "report", (unsigned long)m.reports,
+           r.received ? (double)r.unarmed_sum / r.received : 0.0);
+
+    tuh_hid_umount_cb(1, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Verteilung nach Report-ID: Kosten eines Tastatur-Reports am Funk-Empfänger
+// gegen einen Maus-Report desselben Interfaces
+// -----------------------------------------------------------------------------
+void bench_dispatch(void)
+{
+    std::vector<uint8_t> desc(desc_keyboard_id1, desc_keyboard_id1 + sizeof(desc_keyboard_id1));
+    desc.insert(desc.end(), desc_id12, desc_id12 + sizeof(desc_id12));
+
+    hid_setup_set_policy(BOOT_POLICY_AUTO);
+    host_usb_set_device(1, 0x046d, 0xc52b);
+    host_usb_set_protocol(1, 0, HID_ITF_PROTOCOL_NONE, HID_PROTOCOL_REPORT);
+    tuh_hid_mount_cb(1, 0, desc.data(), (uint16_t)desc.size());
+    hid_setup_service();
+
+    uint8_t const ids[] = { 1, 2 };
+    for (uint8_t id : ids) {
+        uint8_t report[9] = { id };
+        hid_reports_reset_stats();
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < REPORTS; i++) {
+            report[3] = (uint8_t)i;
+            tuh_hid_report_received_cb(1, 0, report, id == 1 ? 9 : 7);
+            hid_reports_service();
+        }
+        double ns = ns_per(t0, REPORTS);
+        hid_reports_stats_t const r = hid_reports_get_stats();
+        printf("dispatch %-12s %7.2f ns/report  [%lu processed, %lu filtered]\n",
+               id == 1 ? "keyboard" : "mouse", ns, (unsigned long)r.processed, (unsigned long)r.filtered);
+    }
+
+    tuh_hid_umount_cb(1, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Zusammenführen: Kosten je Report bei 1 und bei allen möglichen Mäusen
+// -----------------------------------------------------------------------------
+void bench_merge(merge_policy_t policy, char const* name)
+{
+    uint32_t const counts[] = { 1, HID_POOL_SIZE };
+    hid_device_t*  mice[HID_POOL_SIZE];
+
+    mouse_merge_set_policy(policy);
+    for (uint32_t n : counts) {
+        for (uint32_t m = 0; m < n; m++) {
+            mice[m] = hid_pool_claim((uint8_t)(1 + m / CFG_TUH_HID), (uint8_t)(m % CFG_TUH_HID));
+            mouse_merge_attach(mice[m]);
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < REPORTS; i++) {
+            mouse_merge_report(mice[i % n], (int32_t)(rng() % 5) - 2, (int32_t)(rng() % 5) - 2, 0, i);
+        }
+        printf("merge   %-11s %2lu %7.2f ns/report\n", name, (unsigned long)n, ns_per(t0, REPORTS));
+
+        for (uint32_t m = 0; m < n; m++) {
+            mouse_merge_detach(mice[m]);
+            hid_pool_release(mice[m]->dev_addr, mice[m]->instance);
+        }
+    }
+    mouse_merge_set_policy(MERGE_SUM);
+}
+
+// -----------------------------------------------------------------------------
+// Ballistik je Profil; langsame Bewegung (1000 x +1 Count) mit Restübertrag
+// gegen abgeschnittene Ganzzahl-Skalierung
+// -----------------------------------------------------------------------------
+void bench_ballistics(ballistics_profile_t profile)
+{
+    ballistics_set_profile(profile);
+
+    ballistics_t b = {};
+    ballistics_set_interval(&b, 0);
+    int32_t acc = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        int32_t dx = (int32_t)(rng() % 41) - 20;
+        int32_t dy = (int32_t)(rng() % 41) - 20;
+        ballistics_apply(&b, &dx, &dy);
+        acc += dx + dy;
+    }
+    double ns = ns_per(t0, REPORTS);
+    sink = acc;
+
+    ballistics_t slow = {};
+    ballistics_set_interval(&slow, 0);
+    int32_t carried = 0, truncated = 0;
+    for (int i = 0; i < 1000; i++) {
+        int32_t dx = 1, dy = 0;
+        ballistics_apply(&slow, &dx, &dy);
+        carried += dx;
+
+        ballistics_t none = {};   // ohne Übertrag
+        ballistics_set_interval(&none, 0);
+        dx = 1, dy = 0;
+        ballistics_apply(&none, &dx, &dy);
+        truncated += dx;
+    }
+
+    // Dieselbe Handbewegung (24 Counts je 8 ms) mit 125 und 1000 Hz
+    int32_t at_rate[2] = {};
+    uint32_t const interval_us[2] = { 8000, 1000 };
+    for (int r = 0; r < 2; r++) {
+        ballistics_t m = {};
+        ballistics_set_interval(&m, interval_us[r]);
+        uint32_t const per_report = 24 * interval_us[r] / 8000;
+        for (uint32_t t = 0; t < 800000; t += interval_us[r]) {
+            int32_t dx = (int32_t)per_report, dy = 0;
+            ballistics_apply(&m, &dx, &dy);
+            at_rate[r] += dx;
+        }
+    }
+
+    printf("ballist %-13s %7.2f ns/report, slow 1000x(+1): out=%ld (without carry %ld), 125/1000 Hz: %ld/%ld\n",
+           ballistics_profile_name(profile), ns, (long)carried, (long)truncated, (long)at_rate[0], (long)at_rate[1]);
+    ballistics_set_profile(BALLISTICS_LINEAR);
+}
+
+// -----------------------------------------------------------------------------
+// Akkumulieren + MSX-Lesezyklus, inkl. Prüfung auf Bewegungserhaltung
+// -----------------------------------------------------------------------------
+void drain(void)
+{
+    int8_t x, y;
+    do {
+        msx_host_read(&x, &y);
+    } while (x || y);
+}
+
+// -----------------------------------------------------------------------------
+// Ausgangsprotokoll: direkter Aufruf der Policy-Klasse gegen Aufruf über die
+// Funktionstabelle des Laufzeit-Builds (gleiches Back-End)
+// -----------------------------------------------------------------------------
+template <class Backend>
+double backend_ns(void)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        Backend::add_motion((int32_t)(i & 7) - 3, (int32_t)(i & 3) - 1, i);
+    }
+    return ns_per(t0, REPORTS);
+}
+
+void bench_backend(void)
+{
+    using Static = output_backend_by_id<OUTPUT_MSX_MOUSE>::type;
+
+    RuntimeBackend::ops = &output_backend_table[OUTPUT_MSX_MOUSE];
+
+    // Bester von mehreren Durchläufen, abwechselnd gemessen
+    double direct = 1e9, runtime = 1e9;
+    for (int run = 0; run < 5; run++) {
+        direct  = std::min(direct, backend_ns<Static>());
+        runtime = std::min(runtime, backend_ns<RuntimeBackend>());
+    }
+    printf("backend %-13s %7.2f ns/report direct, %.2f ns/report via table (+%.2f)\n",
+           Static::name(), direct, runtime, runtime - direct);
+    drain();
+}
+
+// -----------------------------------------------------------------------------
+// Joystick-Emulation: Pulsdichte je Geschwindigkeit (1 s virtuelle Zeit,
+// Reports mit 125 Hz)
+// -----------------------------------------------------------------------------
+void bench_joystick(void)
+{
+    int32_t const speeds[] = { 1, 4, 8, 16, 32, 64 };   // Counts je Report
+
+    for (int32_t speed : speeds) {
+        host_time_set(0);
+        msx_joystick_init();
+        msx_joystick_stats_t const before = msx_joystick_get_stats();
+
+        for (uint32_t t = 0; t < 1000000; t += 1000) {
+            if (t % 8000 == 0) msx_joystick_add_motion(speed, 0, t);
+            host_time_set(t + 1000);
+        }
+
+        msx_joystick_stats_t const s = msx_joystick_get_stats();
+        uint32_t const ticks  = s.ticks - before.ticks;
+        uint32_t const pulses = s.pulses_x - before.pulses_x;
+        printf("joystick %3ld counts/report: %3lu%% pulse density (%lu/%lu ticks), dropped %lu\n",
+               (long)speed, (unsigned long)(ticks ? pulses * 100 / ticks : 0),
+               (unsigned long)pulses, (unsigned long)ticks, (unsigned long)(s.dropped - before.dropped));
+        msx_joystick_deinit();
+    }
+    host_time_real();
+}
+
+void bench_output(void)
+{
+    int64_t in_x = 0, in_y = 0, out_x = 0, out_y = 0;
+
+    drain();   // Bewegung aus den vorherigen Läufen verwerfen
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        int32_t dx = (int32_t)(rng() % 401) - 200;
+        int32_t dy = (int32_t)(rng() % 401) - 200;
+        msx_output_add_motion(dx, dy, 0);
+        in_x += dx;
+        in_y += dy;
+
+        int8_t x, y;
+        msx_host_read(&x, &y);
+        out_x += x;
+        out_y += y;
+    }
+    double ns = ns_per(t0, REPORTS);
+
+    // Rest abholen: was über +-127 hinausging, muss noch nachkommen
+    for (int i = 0; i < 1000; i++) {
+        int8_t x, y;
+        msx_host_read(&x, &y);
+        out_x += x;
+        out_y += y;
+    }
+
+    printf("output  add+read      %7.2f ns/read\n", ns);
+    printf("motion  in=(%lld,%lld) out=(%lld,%lld) %s\n",
+           (long long)in_x, (long long)in_y, (long long)-out_x, (long long)-out_y,
+           (in_x == -out_x && in_y == -out_y) ? "conserved" : "LOST");
+}
+
+// -----------------------------------------------------------------------------
+// Tasten direkt auf die Trigger-Pins: jeder Aufruf ist eine Flanke
+// -----------------------------------------------------------------------------
+void bench_buttons(void)
+{
+    msx_buttons_reset_stats();
+    latency_reset();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPORTS; i++) {
+        msx_buttons_write((uint8_t)(i & MOUSE_BUTTON_LEFT), time_us_32());
+    }
+    double ns = ns_per(t0, REPORTS);
+    msx_buttons_write(0, time_us_32());
+
+    msx_buttons_stats_t const s = msx_buttons_get_stats();
+    latency_summary_t const lat = latency_get_button_summary();
+    printf("buttons direct write  %7.2f ns/edge, edges=%lu, report->pin max=%lu us\n",
+           ns, (unsigned long)s.edges, (unsigned long)lat.max_us);
+}
+
+// -----------------------------------------------------------------------------
+// Strobe-Watchdog: Sampler bricht nach zwei Nibbles ab; nach dem Fenster muss
+// das nächste Lesen wieder mit X high beginnen und die volle Bewegung liefern
+// -----------------------------------------------------------------------------
+void bench_resync(void)
+{
+    drain();
+    uint32_t const before = msx_output_resync_count();
+
+    host_time_set(0);
+    msx_output_add_motion(-50, 30, 0);
+    msx_host_strobe(true);
+    msx_host_strobe(false);   // X gelesen, Y nicht: Abbruch
+    host_time_set(3 * ROLAND_MSX_STROBE_TIMEOUT_US);
+
+    int8_t x, y;
+    msx_host_read(&x, &y);
+    uint32_t const resyncs = msx_output_resync_count() - before;
+    printf("resync  aborted read: next read (%d,%d), resyncs=%lu %s\n", x, y, (unsigned long)resyncs,
+           (x == 50 && y == -30 && resyncs == 1) ? "ok" : "OUT OF PHASE");
+    drain();
+}
+
+// -----------------------------------------------------------------------------
+// Einstellungs-Log: viele Änderungen über mehrere Sektorwechsel, dann Laden.
+// Der neueste Satz gewinnt, ein abgerissener letzter Satz fällt auf den
+// vorigen zurück, und die Zahl der Satzzugriffe beim Laden bleibt konstant.
+// -----------------------------------------------------------------------------
+void bench_settings(void)
+{
+    uint16_t const start_scale = ballistics_scale();
+    host_flash_reset();
+    uint64_t t = 1000000000;   // weit nach dem letzten Report der übrigen Messungen
+    host_time_set(t);
+    settings_init();
+    uint8_t const empty_reads = settings_get_stats().load_reads;
+
+    constexpr uint32_t CHANGES = 1000;
+    uint32_t max_reads = 0;
+    uint16_t last_scale = 0;
+    for (uint32_t i = 0; i < CHANGES; i++) {
+        last_scale = (uint16_t)(50 + i % 300);
+        ballistics_set_scale(last_scale);
+        // Wartezeit abwarten, dann bis zum Ende des Schreibens bedienen
+        for (int step = 0; step < 4; step++) {
+            settings_service();
+            t += 1000000;
+            host_time_set(t);
+        }
+        if (i % 97 == 0) {
+            settings_init();
+            max_reads = std::max<uint32_t>(max_reads, settings_get_stats().load_reads);
+        }
+    }
+
+    settings_stats_t const s = settings_get_stats();
+    ballistics_set_scale(100);
+    auto t0 = std::chrono::steady_clock::now();
+    constexpr uint32_t LOADS = 1u << 14;
+    for (uint32_t i = 0; i < LOADS; i++) settings_init();
+    double ns = ns_per(t0, LOADS);
+    max_reads = std::max<uint32_t>(max_reads, settings_get_stats().load_reads);
+    bool const newest = ballistics_scale() == last_scale;
+
+    // Letzten Satz beschädigen: der vorige muss gelten
+    settings_stats_t const before = settings_get_stats();
+    uint32_t const slot = before.slot ? before.slot - 1u : 0u;
+    host_flash[PICO_FLASH_SIZE_BYTES - (ROLAND_SETTINGS_SECTORS - before.sector) * FLASH_SECTOR_SIZE +
+               slot * SETTINGS_RECORD_SIZE + SETTINGS_RECORD_SIZE - 1u] ^= 0x01;
+    settings_init();
+    bool const torn = settings_get_stats().seq == before.seq - 1u &&
+                      ballistics_scale() == (uint16_t)(last_scale - 1u);
+
+    printf("settings %lu changes: writes=%lu erases=%lu failed=%lu, load %6.1f ns, reads <= %lu (empty %u), newest %s, torn %s\n",
+           (unsigned long)CHANGES, (unsigned long)s.writes, (unsigned long)s.erases, (unsigned long)s.failed,
+           ns, (unsigned long)max_reads, empty_reads,
+           newest ? "ok" : "WRONG", torn ? "ok" : "WRONG");
+
+    ballistics_set_scale(start_scale);
+    host_flash_reset();
+}
+
+// -----------------------------------------------------------------------------
+// Abgerissener Satz 0 in einem frisch gelöschten Sektor: der Sektor wird neu
+// gelöscht, statt dahinter weiterzuschreiben, und nach dem Neustart gilt die
+// neueste Einstellung, nicht die aus dem älteren Sektor
+// -----------------------------------------------------------------------------
+void bench_settings_slot0(void)
+{
+    uint16_t const start_scale = ballistics_scale();
+    host_flash_reset();
+    uint64_t t = 2000000000;
+    host_time_set(t);
+    ballistics_set_scale(50);   // jede der folgenden Skalierungen ist eine Änderung
+    settings_init();
+
+    auto step = [&t]() {
+        settings_service();
+        t += 1000000;
+        host_time_set(t);
+    };
+    auto save = [&step](uint16_t scale) {
+        ballistics_set_scale(scale);
+        for (int i = 0; i < 4; i++) step();
+    };
+
+    // Sektor 0 ganz füllen
+    uint32_t const slots = FLASH_SECTOR_SIZE / SETTINGS_RECORD_SIZE;
+    for (uint32_t i = 0; i < slots; i++) save((uint16_t)(100 + i % 2));
+
+    // Nächste Änderung: erst Sektor 1 löschen, dann Satz 0 abreißen
+    ballistics_set_scale(150);
+    uint32_t const erases = host_flash_erase_count();
+    for (int i = 0; i < 8 && host_flash_erase_count() == erases; i++) step();
+    host_flash_tear_next_program(16);
+    uint32_t const programs = host_flash_program_count();
+    for (int i = 0; i < 8 && host_flash_program_count() == programs; i++) step();
+    uint32_t const failed = settings_get_stats().failed;
+
+    // Weiter bedienen: Wiederholung, dann eine weitere Änderung
+    for (int i = 0; i < 8; i++) step();
+    save(151);
+
+    settings_stats_t const before = settings_get_stats();
+    ballistics_set_scale(start_scale);
+    settings_init();   // Neustart
+    settings_stats_t const after = settings_get_stats();
+    bool const ok = ballistics_scale() == 151 && after.sector == 1 && after.seq == before.seq;
+
+    printf("settings torn slot 0: failed=%lu, erases=%lu, reload scale=%u sector=%u %s\n",
+           (unsigned long)failed, (unsigned long)host_flash_erase_count(), (unsigned)ballistics_scale(),
+           (unsigned)after.sector, ok ? "ok" : "WRONG");
+
+    ballistics_set_scale(start_scale);
+    host_flash_reset();
+}
+
+} // namespace
+
+int main()
+{
+    tusb_init();
+    msx_output_init(MSX_READ_LIMIT);
+    msx_buttons_init();
+    trace_set_live(false);
+
+    bench_decode();
+    bench_callback("boot-desc", desc_boot, sizeof(desc_boot), 0, 4, BOOT_POLICY_NEVER);
+    bench_callback("boot-desc", desc_boot, sizeof(desc_boot), 0, 4, BOOT_POLICY_AUTO);
+    bench_callback("id+12bit", desc_id12, sizeof(desc_id12), 2, 7, BOOT_POLICY_AUTO);
+    bench_dispatch();
+    bench_merge(MERGE_SUM, "sum");
+    bench_merge(MERGE_LAST_ACTIVE, "last-active");
+    bench_merge(MERGE_PRIMARY, "primary");
+    bench_backend();
+    bench_buttons();
+    bench_ballistics(BALLISTICS_LINEAR);
+    bench_ballistics(BALLISTICS_WINDOWS);
+    bench_ballistics(BALLISTICS_SCURVE);
+    bench_output();
+    bench_joystick();
+    bench_resync();
+    bench_settings();
+    bench_settings_slot0();
+    msx_encode_bench();   // Interpolatoren hier nur als Modell: prüft die Gleichheit
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+
+#include "tusb.h"
+
+#include "corpus.h"
+
+static bool parse_hex(std::istringstream& in, std::vector<uint8_t>* out)
+{
+    std::string tok;
+    while (in >> tok) {
+        char* end;
+        unsigned long v = strtoul(tok.c_str(), &end, 16);
+        if (*end || v > 0xFF) return false;
+        out->push_back((uint8_t)v);
+    }
+    return true;
+}
+
+static corpus_interface_t* interface_at(corpus_t* c, unsigned long inst)
+{
+    if (inst >= CFG_TUH_HID) return nullptr;
+    if (c->itf.size() <= inst) c->itf.resize(inst + 1);
+    return &c->itf[inst];
+}
+
+bool corpus_load(char const* path, corpus_t* c, std::string* error)
+{
+    std::ifstream file(path);
+    if (!file) {
+        *error = "cannot open file";
+        return false;
+    }
+
+    c->name = path;
+    char const* slash = strrchr(path, '/');
+    if (slash) c->name = slash + 1;
+
+    std::string line;
+    unsigned lineno = 0;
+    while (std::getline(file, line)) {
+        lineno++;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream in(line);
+        std::string kind;
+        in >> kind;
+        bool ok = true;
+
+        if (kind == "device") {
+            std::string kv;
+            while (in >> kv) {
+                if (!kv.compare(0, 4, "vid=")) c->vid = (uint16_t)strtoul(kv.c_str() + 4, nullptr, 16);
+                else if (!kv.compare(0, 4, "pid=")) c->pid = (uint16_t)strtoul(kv.c_str() + 4, nullptr, 16);
+            }
+        } else if (kind == "itf") {
+            unsigned long inst;
+            corpus_interface_t* itf = (in >> inst) ? interface_at(c, inst) : nullptr;
+            ok = itf != nullptr;
+            std::string kv;
+            while (ok && in >> kv) {
+                if (kv == "protocol=mouse")         itf->itf_protocol = HID_ITF_PROTOCOL_MOUSE;
+                else if (kv == "protocol=keyboard") itf->itf_protocol = HID_ITF_PROTOCOL_KEYBOARD;
+                else if (kv == "protocol=none")     itf->itf_protocol = HID_ITF_PROTOCOL_NONE;
+                else if (kv == "mode=boot")         itf->protocol = HID_PROTOCOL_BOOT;
+                else if (kv == "mode=report")       itf->protocol = HID_PROTOCOL_REPORT;
+                else if (!kv.compare(0, 9, "interval=")) itf->interval_ms = (uint8_t)atoi(kv.c_str() + 9);
+                else ok = false;
+            }
+        } else if (kind == "desc") {
+            unsigned long inst;
+            corpus_interface_t* itf = (in >> inst) ? interface_at(c, inst) : nullptr;
+            ok = itf && parse_hex(in, &itf->desc);
+        } else if (kind == "r") {
+            unsigned long inst, t;
+            corpus_report_t r;
+            ok = (in >> inst >> t) && inst < c->itf.size();
+            if (ok) {
+                r.instance = (uint8_t)inst;
+                r.t_us     = (uint32_t)t;
+                ok = parse_hex(in, &r.data) && !r.data.empty();
+            }
+            if (ok) c->reports.push_back(std::move(r));
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            *error = "line " + std::to_string(lineno) + ": " + line;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef _CORPUS_H_
+#define _CORPUS_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Korpus aufgezeichneter HID-Reports (Textformat, eine Zeile je Eintrag)
+//
+//   # roland-hid-corpus v1                      Kommentare mit '#'
+//   device vid=046d pid=c52b
+//   itf <inst> protocol=mouse|keyboard|none mode=boot|report interval=<ms>
+//   desc <inst> <hex bytes>                     Report-Deskriptor
+//   r <inst> <t_us> <hex bytes>                 Report, Zeit ab Aufnahmebeginn
+// -----------------------------------------------------------------------------
+
+struct corpus_interface_t {
+    uint8_t              itf_protocol = 0;   // HID_ITF_PROTOCOL_*
+    uint8_t              protocol     = 1;   // HID_PROTOCOL_BOOT/REPORT
+    uint8_t              interval_ms  = 0;   // bInterval des Interrupt-Endpunkts
+    std::vector<uint8_t> desc;
+};
+
+struct corpus_report_t {
+    uint8_t              instance;
+    uint32_t             t_us;
+    std::vector<uint8_t> data;
+};
+
+struct corpus_t {
+    std::string                     name;
+    uint16_t                        vid = 0;
+    uint16_t                        pid = 0;
+    std::vector<corpus_interface_t> itf;
+    std::vector<corpus_report_t>    reports;
+};
+
+// false und Meldung in *error bei Syntaxfehlern
+bool corpus_load(char const* path, corpus_t* corpus, std::string* error);
+
+#endif
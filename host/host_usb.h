@@ -0,0 +1,43 @@
+#ifndef _HOST_USB_H_
+#define _HOST_USB_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Steuerung der TinyUSB-Nachbildung im Host-Build
+// -----------------------------------------------------------------------------
+
+// Angaben, die tuh_vid_pid_get()/tuh_hid_*_protocol() liefern sollen
+void host_usb_set_device(uint8_t dev_addr, uint16_t vid, uint16_t pid);
+void host_usb_set_protocol(uint8_t dev_addr, uint8_t instance,
+                           uint8_t itf_protocol, uint8_t protocol);
+
+// bInterval im Konfigurationsdeskriptor (tuh_descriptor_get_configuration)
+void host_usb_set_interval(uint8_t dev_addr, uint8_t instance, uint8_t interval_ms);
+
+// Anzahl der tuh_hid_receive_report()-Aufrufe
+uint32_t host_usb_receive_count(void);
+
+// Anzahl der SET_IDLE-Requests über tuh_control_xfer()
+uint32_t host_usb_set_idle_count(void);
+
+// Uhr: feste Zeit vorgeben (z. B. Korpus-Zeit) bzw. zurück zur echten Zeit
+void host_time_set(uint64_t us);
+void host_time_real(void);
+
+// Zustand der nachgebildeten GPIOs
+uint32_t host_gpio_state(void);
+
+// Flash-Abbild (hardware/flash.h): ganz gelöscht, Zähler auf 0
+void host_flash_reset(void);
+uint32_t host_flash_erase_count(void);
+uint32_t host_flash_program_count(void);
+// Nächstes flash_range_program nach so vielen Bytes abbrechen (Stromausfall)
+void host_flash_tear_next_program(uint32_t bytes);
+
+// Wird nach jedem SIO-Zugriff (gpio_put, gpio_put_masked, gpio_init) mit der
+// geschriebenen Maske und allen Pegeln danach aufgerufen; nullptr = aus
+typedef void (*host_gpio_hook_t)(uint32_t mask, uint32_t levels);
+void host_gpio_set_hook(host_gpio_hook_t hook);
+
+#endif
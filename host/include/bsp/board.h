@@ -0,0 +1,6 @@
+#ifndef _HOST_BSP_BOARD_H_
+#define _HOST_BSP_BOARD_H_
+
+void board_init(void);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef _HOST_HID_HOST_H_
+#define _HOST_HID_HOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct __attribute__((packed)) {
+    uint8_t buttons;
+    int8_t  x;
+    int8_t  y;
+    int8_t  wheel;
+    int8_t  pan;
+} hid_mouse_report_t;
+
+enum {
+    MOUSE_BUTTON_LEFT     = 1u << 0,
+    MOUSE_BUTTON_RIGHT    = 1u << 1,
+    MOUSE_BUTTON_MIDDLE   = 1u << 2,
+    MOUSE_BUTTON_BACKWARD = 1u << 3,
+    MOUSE_BUTTON_FORWARD  = 1u << 4,
+};
+
+enum {
+    HID_ITF_PROTOCOL_NONE     = 0,
+    HID_ITF_PROTOCOL_KEYBOARD = 1,
+    HID_ITF_PROTOCOL_MOUSE    = 2,
+};
+
+enum {
+    HID_PROTOCOL_BOOT   = 0,
+    HID_PROTOCOL_REPORT = 1,
+};
+
+enum {
+    HID_REQ_CONTROL_SET_IDLE = 0x0A,
+};
+
+uint8_t tuh_hid_interface_protocol(uint8_t dev_addr, uint8_t idx);
+uint8_t tuh_hid_get_protocol(uint8_t dev_addr, uint8_t idx);
+bool    tuh_hid_receive_report(uint8_t dev_addr, uint8_t idx);
+void    tuh_hid_set_default_protocol(uint8_t protocol);
+bool    tuh_hid_set_protocol(uint8_t dev_addr, uint8_t idx, uint8_t protocol);
+bool    tuh_hid_itf_get_info(uint8_t dev_addr, uint8_t idx, tuh_itf_info_t* itf_info);
+
+// Von der Firmware bereitgestellt
+void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t idx, uint8_t const* desc_report, uint16_t desc_len);
+void tuh_hid_umount_cb(uint8_t dev_addr, uint8_t idx);
+void tuh_hid_set_protocol_complete_cb(uint8_t dev_addr, uint8_t idx, uint8_t protocol);
+void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t idx, uint8_t const* report, uint16_t len);
+
+#endif
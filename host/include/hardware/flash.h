@@ -0,0 +1,26 @@
+#ifndef _HOST_HARDWARE_FLASH_H_
+#define _HOST_HARDWARE_FLASH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// -----------------------------------------------------------------------------
+// Host-Build: Flash als RAM-Abbild (host/stubs.cpp). Löschen setzt auf 0xFF,
+// Programmieren kann wie beim NOR-Flash nur Bits von 1 auf 0 ziehen.
+// -----------------------------------------------------------------------------
+
+#define FLASH_PAGE_SIZE   (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2u * 1024 * 1024)
+#endif
+
+// Lesezugriff wie über XIP: XIP_BASE + Offset
+extern uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)host_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, uint8_t const* data, size_t count);
+
+#endif
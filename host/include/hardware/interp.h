@@ -0,0 +1,114 @@
+#ifndef _HOST_HARDWARE_INTERP_H_
+#define _HOST_HARDWARE_INTERP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Host-Modell der RP2040-Interpolatoren (nur die benutzten Funktionen)
+//
+// Lane-Ergebnis: ((ACCUM >> shift) & mask), bei signed vorzeichenerweitert,
+// plus BASE. Volles Ergebnis: BASE2 + beide Lanes ohne BASE.
+//
+// Wie auf dem RP2040 gibt es die Sondermodi nur je auf einem Interpolator;
+// auf dem anderen ist das Bit reserviert und wirkungslos:
+//   Clamp (nur interp1)  Lane 0 wird auf BASE0..BASE1 begrenzt
+//   Blend (nur interp0)  Lane 1 = BASE0 + alpha * (BASE1 - BASE0) / 256 mit
+//                        alpha = Bits 0-7 von Lane 1 ohne BASE; Lane 0
+//                        liefert dann nur ihren Wert ohne BASE0
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t shift;
+    uint8_t mask_lsb;
+    uint8_t mask_msb;
+    bool    is_signed;
+    bool    clamp;   // Lane 0, nur interp1
+    bool    blend;   // Lane 0, nur interp0
+} interp_config;
+
+typedef struct {
+    uint32_t      accum[2];
+    uint32_t      base[3];
+    interp_config ctrl[2];
+} interp_hw_t;
+
+inline interp_hw_t host_interp[2];
+
+#define interp0 (&host_interp[0])
+#define interp1 (&host_interp[1])
+
+static inline interp_config interp_default_config(void)
+{
+    interp_config c = { 0, 0, 31, false, false, false };
+    return c;
+}
+
+static inline void interp_config_set_shift(interp_config* c, unsigned shift) { c->shift = (uint8_t)shift; }
+static inline void interp_config_set_signed(interp_config* c, bool is_signed) { c->is_signed = is_signed; }
+static inline void interp_config_set_clamp(interp_config* c, bool clamp) { c->clamp = clamp; }
+static inline void interp_config_set_blend(interp_config* c, bool blend) { c->blend = blend; }
+
+static inline void interp_config_set_mask(interp_config* c, unsigned lsb, unsigned msb)
+{
+    c->mask_lsb = (uint8_t)lsb;
+    c->mask_msb = (uint8_t)msb;
+}
+
+static inline void interp_set_config(interp_hw_t* interp, unsigned lane, interp_config* c)
+{
+    interp->ctrl[lane] = *c;
+}
+
+static inline void interp_set_base(interp_hw_t* interp, unsigned lane, uint32_t val)
+{
+    interp->base[lane] = val;
+}
+
+static inline void interp_set_accumulator(interp_hw_t* interp, unsigned lane, uint32_t val)
+{
+    interp->accum[lane] = val;
+}
+
+static inline uint32_t host_interp_lane_raw(interp_hw_t const* interp, unsigned lane)
+{
+    interp_config const* c = &interp->ctrl[lane];
+    uint32_t const mask = (0xFFFFFFFFu >> (31 - c->mask_msb)) & (0xFFFFFFFFu << c->mask_lsb);
+    uint32_t v = (interp->accum[lane] >> c->shift) & mask;
+    if (c->is_signed && c->mask_msb < 31 && (v >> c->mask_msb) & 1) v |= 0xFFFFFFFFu << c->mask_msb;
+    return v;
+}
+
+static inline uint32_t interp_peek_lane_result(interp_hw_t* interp, unsigned lane)
+{
+    uint32_t const v = host_interp_lane_raw(interp, lane);
+    bool const blend = interp == interp0 && interp->ctrl[0].blend;
+    if (blend && lane == 0) return v;
+    if (blend && lane == 1) {
+        uint32_t const alpha = v & 0xFF;
+        if (interp->ctrl[1].is_signed) {
+            int64_t const d = (int64_t)(int32_t)interp->base[1] - (int32_t)interp->base[0];
+            return (uint32_t)((int32_t)interp->base[0] + (int32_t)(d * alpha / 256));
+        }
+        int64_t const d = (int64_t)interp->base[1] - (int64_t)interp->base[0];
+        return interp->base[0] + (uint32_t)(d * (int64_t)alpha / 256);
+    }
+    if (lane == 0 && interp == interp1 && interp->ctrl[0].clamp) {
+        if (interp->ctrl[0].is_signed) {
+            if ((int32_t)v < (int32_t)interp->base[0]) return interp->base[0];
+            if ((int32_t)v > (int32_t)interp->base[1]) return interp->base[1];
+        } else {
+            if (v < interp->base[0]) return interp->base[0];
+            if (v > interp->base[1]) return interp->base[1];
+        }
+        return v;
+    }
+    return interp->base[lane] + v;
+}
+
+static inline uint32_t interp_peek_full_result(interp_hw_t* interp)
+{
+    return interp->base[2] + host_interp_lane_raw(interp, 0) + host_interp_lane_raw(interp, 1);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef _HOST_HARDWARE_STRUCTS_SCB_H_
+#define _HOST_HARDWARE_STRUCTS_SCB_H_
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t scr;
+} armv6m_scb_hw_t;
+
+extern armv6m_scb_hw_t host_scb;
+#define scb_hw (&host_scb)
+
+#define M0PLUS_SCR_SEVONPEND_BITS 0x00000010u
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef _HOST_HARDWARE_UART_H_
+#define _HOST_HARDWARE_UART_H_
+
+#include "pico/stdlib.h"
+
+typedef struct uart_inst uart_inst_t;
+
+static inline uart_inst_t* uart_get_instance(uint num) { (void) num; return (uart_inst_t*)0; }
+
+bool uart_is_writable(uart_inst_t* uart);
+void uart_putc_raw(uart_inst_t* uart, char c);
+
+#endif
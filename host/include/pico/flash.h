@@ -0,0 +1,20 @@
+#ifndef _HOST_PICO_FLASH_H_
+#define _HOST_PICO_FLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host-Build: kein zweiter Core, kein XIP; die Funktion läuft direkt
+
+#define PICO_OK 0
+
+static inline int flash_safe_execute(void (*func)(void*), void* param, uint32_t enter_exit_timeout_ms)
+{
+    (void)enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
+
+static inline bool flash_safe_execute_core_init(void) { return true; }
+
+#endif
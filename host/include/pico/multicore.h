@@ -0,0 +1,6 @@
+#ifndef _HOST_PICO_MULTICORE_H_
+#define _HOST_PICO_MULTICORE_H_
+
+// Host-Build ist immer einkernig (ROLAND_MULTICORE=0)
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef _HOST_PICO_STDLIB_H_
+#define _HOST_PICO_STDLIB_H_
+
+// -----------------------------------------------------------------------------
+// Host-Build: schmale Nachbildung der benutzten pico-sdk-Funktionen
+// (Implementierung in host/stubs.cpp)
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define __isr
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_DEFAULT_UART  0
+
+#define GPIO_IN  false
+#define GPIO_OUT true
+
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + 1000ull * ms; }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+
+// Wiederholender Timer; im Host-Build nur mit host_time_set() (virtuelle
+// Uhr) ausgelöst, dann synchron in der Reihenfolge der Fälligkeit
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* rt);
+
+struct repeating_timer {
+    int64_t                    delay_us;
+    repeating_timer_callback_t callback;
+    void*                      user_data;
+    uint64_t                   host_due_us;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out);
+bool cancel_repeating_timer(repeating_timer_t* timer);
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout);
+
+bool stdio_init_all(void);
+int  getchar_timeout_us(uint32_t timeout_us);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+void gpio_put_masked(uint32_t mask, uint32_t value);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all(void);
+
+#endif
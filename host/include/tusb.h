@@ -0,0 +1,114 @@
+#ifndef _HOST_TUSB_H_
+#define _HOST_TUSB_H_
+
+// -----------------------------------------------------------------------------
+// Host-Build: benutzte Teile der TinyUSB-Host-API
+// (Implementierung in host/stubs.cpp, Steuerung über host/host_usb.h)
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OPT_MCU_RP2040      1
+#define OPT_OS_PICO         1
+#define OPT_MODE_HOST       0x0002
+#define OPT_MODE_FULL_SPEED 0x0400
+
+typedef enum {
+    TUSB_DIR_OUT = 0,
+    TUSB_DIR_IN  = 1,
+} tusb_dir_t;
+
+typedef enum {
+    TUSB_REQ_TYPE_STANDARD = 0,
+    TUSB_REQ_TYPE_CLASS,
+    TUSB_REQ_TYPE_VENDOR,
+} tusb_request_type_t;
+
+typedef enum {
+    TUSB_REQ_RCPT_DEVICE = 0,
+    TUSB_REQ_RCPT_INTERFACE,
+    TUSB_REQ_RCPT_ENDPOINT,
+    TUSB_REQ_RCPT_OTHER,
+} tusb_request_recipient_t;
+
+enum {
+    TUSB_DESC_CONFIGURATION = 0x02,
+    TUSB_DESC_INTERFACE     = 0x04,
+    TUSB_DESC_ENDPOINT      = 0x05,
+    HID_DESC_TYPE_HID       = 0x21,
+};
+
+enum {
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS,
+    TUSB_XFER_BULK,
+    TUSB_XFER_INTERRUPT,
+};
+
+typedef enum {
+    XFER_RESULT_SUCCESS = 0,
+    XFER_RESULT_FAILED,
+    XFER_RESULT_STALLED,
+    XFER_RESULT_TIMEOUT,
+} xfer_result_t;
+
+typedef struct __attribute__((packed)) {
+    union {
+        struct __attribute__((packed)) {
+            uint8_t recipient : 5;
+            uint8_t type      : 2;
+            uint8_t direction : 1;
+        } bmRequestType_bit;
+        uint8_t bmRequestType;
+    };
+    uint8_t  bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bInterfaceNumber;
+    uint8_t bAlternateSetting;
+    uint8_t bNumEndpoints;
+    uint8_t bInterfaceClass;
+    uint8_t bInterfaceSubClass;
+    uint8_t bInterfaceProtocol;
+    uint8_t iInterface;
+} tusb_desc_interface_t;
+
+typedef struct {
+    uint8_t               daddr;
+    tusb_desc_interface_t desc;
+} tuh_itf_info_t;
+
+struct tuh_xfer_s;
+typedef struct tuh_xfer_s tuh_xfer_t;
+typedef void (*tuh_xfer_cb_t)(tuh_xfer_t* xfer);
+
+struct tuh_xfer_s {
+    uint8_t       daddr;
+    uint8_t       ep_addr;
+    xfer_result_t result;
+    uint32_t      actual_len;
+    tusb_control_request_t const* setup;
+    uint8_t*      buffer;
+    tuh_xfer_cb_t complete_cb;
+    uintptr_t     user_data;
+};
+
+#include "tusb_config.h"
+#include "class/hid/hid_host.h"
+
+bool tusb_init(void);
+void tuh_task(void);
+bool tuh_task_event_ready(void);
+bool tuh_vid_pid_get(uint8_t dev_addr, uint16_t* vid, uint16_t* pid);
+bool tuh_control_xfer(tuh_xfer_t* xfer);
+bool tuh_descriptor_get_configuration(uint8_t daddr, uint8_t index, void* buffer, uint16_t len,
+                                      tuh_xfer_cb_t complete_cb, uintptr_t user_data);
+
+#endif
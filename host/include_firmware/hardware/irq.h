@@ -0,0 +1,17 @@
+#ifndef _HOST_HARDWARE_IRQ_H_
+#define _HOST_HARDWARE_IRQ_H_
+
+// Nur Deklarationen, siehe hardware/pio.h
+
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define PIO0_IRQ_0 7
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+void irq_set_pending(uint num);
+
+#endif
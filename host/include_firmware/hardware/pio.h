@@ -0,0 +1,68 @@
+#ifndef _HOST_HARDWARE_PIO_H_
+#define _HOST_HARDWARE_PIO_H_
+
+// -----------------------------------------------------------------------------
+// Nur Deklarationen: src/msx_output.cpp wird im Host-Build übersetzt, aber
+// nicht gelinkt (roland_firmware_check)
+// -----------------------------------------------------------------------------
+
+#include "pico/stdlib.h"
+
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t* PIO;
+
+extern pio_hw_t* const host_pio0;
+#define pio0 host_pio0
+
+typedef struct {
+    uint16_t const* instructions;
+    uint8_t         length;
+    int8_t          origin;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv, execctrl, shiftctrl, pinctrl;
+} pio_sm_config;
+
+typedef enum {
+    pis_interrupt0 = 8,
+} pio_interrupt_source;
+
+enum pio_src_dest {
+    pio_x = 1,
+};
+
+uint pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_unclaim(PIO pio, uint sm);
+uint pio_add_program(PIO pio, pio_program_t const* program);
+void pio_remove_program(PIO pio, pio_program_t const* program, uint loaded_offset);
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, pio_sm_config const* config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_restart(PIO pio, uint sm);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+uint8_t pio_sm_get_pc(PIO pio, uint sm);
+void pio_gpio_init(PIO pio, uint pin);
+int  pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+
+void     pio_sm_put(PIO pio, uint sm, uint32_t data);
+uint32_t pio_sm_get(PIO pio, uint sm);
+bool     pio_sm_is_rx_fifo_empty(PIO pio, uint sm);
+bool     pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+void     pio_sm_clear_fifos(PIO pio, uint sm);
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num);
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num);
+void pio_set_irq0_source_enabled(PIO pio, pio_interrupt_source source, bool enabled);
+
+uint pio_encode_jmp(uint addr);
+uint pio_encode_set(enum pio_src_dest dest, uint value);
+
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_out_pins(pio_sm_config* c, uint out_base, uint out_count);
+void sm_config_set_in_pins(pio_sm_config* c, uint in_base);
+void sm_config_set_jmp_pin(pio_sm_config* c, uint pin);
+void sm_config_set_out_shift(pio_sm_config* c, bool shift_right, bool autopull, uint pull_threshold);
+void sm_config_set_in_shift(pio_sm_config* c, bool shift_right, bool autopush, uint push_threshold);
+
+#endif
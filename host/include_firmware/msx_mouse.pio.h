@@ -0,0 +1,21 @@
+#ifndef _HOST_MSX_MOUSE_PIO_H_
+#define _HOST_MSX_MOUSE_PIO_H_
+
+// -----------------------------------------------------------------------------
+// Ersatz für den von pioasm erzeugten Header (src/msx_mouse.pio), nur mit den
+// Namen, die src/msx_output.cpp benutzt. Die Offsets sind bewusst keine
+// Werte: gelinkt wird nichts, geprüft werden nur Namen und Typen.
+// -----------------------------------------------------------------------------
+
+#include "hardware/pio.h"
+
+extern uint const msx_mouse_offset_idle;
+extern uint const msx_mouse_offset_cycle;
+extern uint const msx_mouse_offset_partial;
+extern uint const msx_mouse_offset_done;
+
+extern pio_program_t const msx_mouse_program;
+
+void msx_mouse_program_init(PIO pio, uint sm, uint offset, uint data_pin, uint strobe_pin);
+
+#endif
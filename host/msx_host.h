@@ -0,0 +1,22 @@
+#ifndef _MSX_HOST_H_
+#define _MSX_HOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Host-Modell des PIO-Ausgangs (msx_mouse.pio)
+//
+// Der Aufrufer spielt den Sampler: er setzt den Strobe-Pegel und liest die
+// vier Datenleitungen. Das Modell verhält sich wie die State-Machine samt
+// IRQ-Handler (Snapshot bei der ersten Flanke, Verbuchen nach dem vierten
+// Nibble).
+// -----------------------------------------------------------------------------
+
+// Strobe-Pegel setzen; liefert das danach auf D0..D3 anliegende Nibble
+uint8_t msx_host_strobe(bool level);
+
+// Kompletter Lesezyklus wie die MSX-BIOS-Routine
+void msx_host_read(int8_t* x, int8_t* y);
+
+#endif
@@ -0,0 +1,146 @@
+#include "pico/stdlib.h"
+
+#include "latency.h"
+#include "motion_accumulator.h"
+#include "msx_encode.h"
+#include "msx_host.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+#include "pin_masks.h"
+#include "pins.h"
+
+// -----------------------------------------------------------------------------
+// Host-Ersatz für msx_output.cpp: gleiche API, PIO durch ein Modell ersetzt
+// -----------------------------------------------------------------------------
+
+static MotionAccumulator motion;
+
+static uint32_t read_count;
+static uint32_t carry_count;
+static uint32_t resync_count;
+
+static bool     strobe;
+static bool     in_cycle;
+static uint8_t  nibble_index;
+static uint32_t snapshot;
+
+// Strobe-Watchdog wie in msx_output.cpp (msx_strobe_watch), Nibble-Index
+// statt Programmzähler
+static repeating_timer_t  watchdog;
+static msx_strobe_watch_t watch;
+
+// Wie die PIO ("out pins, 4"): alle vier Leitungen in einem Zugriff
+static void put_nibble(uint8_t nibble)
+{
+    gpio_put_masked(MSX_DATA_MASK, msx_nibble_levels(nibble));
+}
+
+static uint8_t pins_nibble(void)
+{
+    return msx_levels_nibble(gpio_get_all());
+}
+
+// Steigende Flanke im Leerlauf (bzw. Strobe high nach dem Zurücksetzen,
+// wie "jmp pin"): neuesten Snapshot übernehmen
+static void start_cycle(void)
+{
+    latency_snapshot();
+    snapshot     = msx_encode_snapshot(motion.pending_x(), motion.pending_y());
+    in_cycle     = true;
+    nibble_index = 0;
+    put_nibble(msx_snapshot_nibble(snapshot, 0));
+}
+
+static bool strobe_watchdog(repeating_timer_t* rt)
+{
+    (void)rt;
+    msx_watch_action_t const action =
+        msx_strobe_watch(&watch, in_cycle, nibble_index > 0, nibble_index, read_count);
+    if (action != MSX_WATCH_OK) {
+        if (action == MSX_WATCH_RESYNC_ABORTED) resync_count++;
+        in_cycle = false;   // nichts verbuchen
+        if (strobe) start_cycle();
+        watch.pos = nibble_index;
+    }
+    return true;
+}
+
+void msx_output_init(int32_t read_limit)
+{
+    msx_encode_init(read_limit);
+    strobe   = false;
+    in_cycle = false;
+
+    cancel_repeating_timer(&watchdog);
+    watch = msx_strobe_watch_t{ 0xFFFFFFFFu, read_count };
+    add_repeating_timer_us(ROLAND_MSX_STROBE_TIMEOUT_US, strobe_watchdog, nullptr, &watchdog);
+}
+
+void msx_output_deinit(void)
+{
+    cancel_repeating_timer(&watchdog);
+    for (uint i = 0; i < 4; i++) {
+        gpio_init(msx_data_pin[i]);
+    }
+}
+
+void msx_output_add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+{
+    if (!dx && !dy) return;
+
+    // MSX-Maus meldet die Gegenrichtung: positiv = links bzw. oben
+    motion.add(-dx, -dy);
+    latency_motion_added(arrival_us);
+}
+
+uint32_t msx_output_read_count(void)
+{
+    return read_count;
+}
+
+uint32_t msx_output_carry_count(void)
+{
+    return carry_count;
+}
+
+uint32_t msx_output_resync_count(void)
+{
+    return resync_count;
+}
+
+uint8_t msx_host_strobe(bool level)
+{
+    if (level == strobe) return pins_nibble();
+    strobe = level;
+
+    if (!in_cycle) {
+        if (!level) return pins_nibble();
+        start_cycle();
+    } else {
+        nibble_index++;
+        put_nibble(msx_snapshot_nibble(snapshot, nibble_index));
+    }
+
+    uint8_t nibble = msx_snapshot_nibble(snapshot, nibble_index);
+
+    if (nibble_index == MSX_NIBBLES_PER_READ - 1) {
+        // entspricht dem IRQ-Handler nach "irq wait"
+        motion.consume(msx_snapshot_x(snapshot), msx_snapshot_y(snapshot));
+        read_count++;
+        bool carry = motion.pending_x() != 0 || motion.pending_y() != 0;
+        if (carry) carry_count++;
+        if (snapshot & 0xFFFF) latency_delivered(time_us_32(), carry);
+        in_cycle = false;
+    }
+    return nibble;
+}
+
+void msx_host_read(int8_t* x, int8_t* y)
+{
+    uint8_t xh = msx_host_strobe(true);
+    uint8_t xl = msx_host_strobe(false);
+    uint8_t yh = msx_host_strobe(true);
+    uint8_t yl = msx_host_strobe(false);
+    *x = (int8_t)((xh << 4) | xl);
+    *y = (int8_t)((yh << 4) | yl);
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+#include "tusb.h"
+
+#include "ballistics.h"
+#include "corpus.h"
+#include "hid_layout.h"
+#include "hid_pool.h"
+#include "hid_reports.h"
+#include "hid_setup.h"
+#include "host_usb.h"
+#include "latency.h"
+#include "msx_buttons.h"
+#include "msx_host.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+#include "trace.h"
+
+// -----------------------------------------------------------------------------
+// Replay aufgezeichneter HID-Reports durch die Firmware-Callbacks
+//
+//   roland_host_replay [--realtime] [--profile linear|windows|s-curve] <korpus.hidr>...
+//
+// Je Korpus: Durchsatz beim Replay, Kosten je Stufe (Dekodierung, kompletter
+// Report-Callback, MSX-Lesezyklus) und Bewegungsbilanz je Achse. Der Sampler
+// liest wie ein MSX im 60-Hz-Takt der Korpus-Zeit; mit --realtime wird
+// zusätzlich das Latenz-Histogramm ausgegeben. Die Soll-Bewegung läuft durch
+// dieselbe Ballistik wie die Firmware. Exit-Code 1, wenn Bewegung verloren
+// ging.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint8_t  DEV_ADDR        = 1;
+constexpr uint32_t SAMPLER_US      = 16667;     // 60 Hz
+constexpr uint32_t MIN_TIMED_CALLS = 1u << 20;  // Stufenmessung über mindestens so viele Aufrufe
+
+using clock_type = std::chrono::steady_clock;
+
+double ns_since(clock_type::time_point t0)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - t0).count();
+}
+
+struct axis_sum_t {
+    int64_t x = 0;
+    int64_t y = 0;
+};
+
+uint32_t drain(axis_sum_t* out)
+{
+    uint32_t reads = 0;
+    int8_t x, y;
+    do {
+        msx_host_read(&x, &y);
+        out->x -= x;   // MSX-Richtung zurück in USB-Richtung
+        out->y -= y;
+        reads++;
+    } while (x || y);
+    return reads;
+}
+
+void build_layout(corpus_interface_t const& itf, hid_mouse_layout_t* layout, bool* valid)
+{
+    if (itf.itf_protocol == HID_ITF_PROTOCOL_MOUSE && itf.protocol == HID_PROTOCOL_BOOT) {
+        hid_layout_boot(layout);
+        *valid = true;
+    } else {
+        *valid = hid_layout_parse(layout, nullptr, itf.desc.data(), (uint16_t)itf.desc.size());
+    }
+}
+
+void mount(corpus_t const& c)
+{
+    host_usb_set_device(DEV_ADDR, c.vid, c.pid);
+    for (size_t i = 0; i < c.itf.size(); i++) {
+        host_usb_set_protocol(DEV_ADDR, (uint8_t)i, c.itf[i].itf_protocol, c.itf[i].protocol);
+        host_usb_set_interval(DEV_ADDR, (uint8_t)i, c.itf[i].interval_ms);
+        tuh_hid_mount_cb(DEV_ADDR, (uint8_t)i, c.itf[i].desc.data(), (uint16_t)c.itf[i].desc.size());
+    }
+    hid_setup_service();   // Protokoll/Idle wie in der Hauptschleife
+}
+
+void umount(corpus_t const& c)
+{
+    for (size_t i = 0; i < c.itf.size(); i++) tuh_hid_umount_cb(DEV_ADDR, (uint8_t)i);
+}
+
+uint32_t passes_for(size_t n)
+{
+    return n ? (uint32_t)((MIN_TIMED_CALLS + n - 1) / n) : 0;
+}
+
+bool replay(corpus_t const& c, bool realtime)
+{
+    size_t const n = c.reports.size();
+    axis_sum_t expected, out, scratch;
+
+    // --- Stufe 1: Dekodierung allein, dabei Soll-Bewegung bestimmen ---------
+    hid_mouse_layout_t layout[CFG_TUH_HID];
+    bool valid[CFG_TUH_HID] = {};
+    for (size_t i = 0; i < c.itf.size(); i++) build_layout(c.itf[i], &layout[i], &valid[i]);
+
+    uint32_t decoded = 0;
+    ballistics_t ballistics[CFG_TUH_HID] = {};
+    for (size_t i = 0; i < c.itf.size(); i++) ballistics_set_interval(&ballistics[i], c.itf[i].interval_ms * 1000u);
+    for (corpus_report_t const& r : c.reports) {
+        hid_mouse_sample_t s;
+        if (valid[r.instance] && hid_layout_decode(&layout[r.instance], r.data.data(), (uint16_t)r.data.size(), &s)) {
+            int32_t dx = s.x;
+            int32_t dy = s.y;
+            ballistics_apply(&ballistics[r.instance], &dx, &dy);
+            expected.x += dx;
+            expected.y += dy;
+            decoded++;
+        }
+    }
+
+    uint32_t passes = passes_for(n);
+    volatile int32_t sink = 0;
+    auto t0 = clock_type::now();
+    for (uint32_t p = 0; p < passes; p++) {
+        for (corpus_report_t const& r : c.reports) {
+            hid_mouse_sample_t s;
+            if (valid[r.instance] && hid_layout_decode(&layout[r.instance], r.data.data(), (uint16_t)r.data.size(), &s)) {
+                sink = sink + s.x;
+            }
+        }
+    }
+    double decode_ns = n ? ns_since(t0) / ((double)passes * n) : 0;
+
+    // --- Stufe 2: kompletter Report-Callback --------------------------------
+    mount(c);
+    t0 = clock_type::now();
+    for (uint32_t p = 0; p < passes; p++) {
+        for (corpus_report_t const& r : c.reports) {
+            tuh_hid_report_received_cb(DEV_ADDR, r.instance, r.data.data(), (uint16_t)r.data.size());
+            hid_reports_service();
+        }
+    }
+    double callback_ns = n ? ns_since(t0) / ((double)passes * n) : 0;
+
+    // --- Stufe 3: MSX-Lesezyklen (baut den Rückstau aus Stufe 2 ab) ---------
+    t0 = clock_type::now();
+    uint32_t reads = drain(&scratch);
+    double read_ns = ns_since(t0) / reads;
+
+    // --- Replay in Korpus-Reihenfolge mit 60-Hz-Sampler ---------------------
+    // Ohne --realtime läuft die Firmware-Uhr in Korpus-Zeit, damit Rate und
+    // Lücken je Instanz stimmen
+    umount(c);
+    mount(c);
+    uint32_t next_read_us = SAMPLER_US;
+    uint32_t sampler_reads = 0;
+    latency_reset();
+    auto start = clock_type::now();
+    for (corpus_report_t const& r : c.reports) {
+        while (r.t_us >= next_read_us) {
+            if (realtime) std::this_thread::sleep_until(start + std::chrono::microseconds(next_read_us));
+            else          host_time_set(next_read_us);
+            int8_t x, y;
+            msx_host_read(&x, &y);
+            out.x -= x;
+            out.y -= y;
+            sampler_reads++;
+            next_read_us += SAMPLER_US;
+        }
+        if (realtime) std::this_thread::sleep_until(start + std::chrono::microseconds(r.t_us));
+        else          host_time_set(r.t_us);
+        tuh_hid_report_received_cb(DEV_ADDR, r.instance, r.data.data(), (uint16_t)r.data.size());
+        hid_reports_service();
+    }
+    double replay_ns = ns_since(start);
+    sampler_reads += drain(&out);
+    host_time_real();
+
+    std::vector<hid_device_t> devs;
+    for (size_t i = 0; i < c.itf.size(); i++) {
+        hid_device_t const* dev = hid_pool_find(DEV_ADDR, (uint8_t)i);
+        if (dev) devs.push_back(*dev);
+    }
+    umount(c);
+
+    uint32_t duration_ms = n ? c.reports.back().t_us / 1000 : 0;
+    bool conserved = expected.x == out.x && expected.y == out.y;
+
+    printf("%s: %zu reports (%lu mouse), %lu ms, %zu interface(s), ballistics %s\n",
+           c.name.c_str(), n, (unsigned long)decoded, (unsigned long)duration_ms, c.itf.size(),
+           ballistics_profile_name(ballistics_profile()));
+    printf("  replay    %10.0f reports/s%s\n", n / (replay_ns * 1e-9), realtime ? " (realtime)" : "");
+    printf("  decode    %10.2f ns/report\n", decode_ns);
+    printf("  callback  %10.2f ns/report\n", callback_ns);
+    printf("  read      %10.2f ns/read\n", read_ns);
+    printf("  motion    x in=%lld out=%lld, y in=%lld out=%lld, %lu sampler reads: %s\n",
+           (long long)expected.x, (long long)out.x, (long long)expected.y, (long long)out.y,
+           (unsigned long)sampler_reads, conserved ? "conserved" : "LOST");
+    for (hid_device_t const& d : devs) {
+        rate_meter_t const* r = &d.rate;
+        printf("  rate      itf %u: bInterval=%lu us, %lu Hz, jitter=%lu us, max=%lu us, gaps=%lu, missed frames=%lu\n",
+               d.instance, (unsigned long)r->expected_us, (unsigned long)rate_meter_hz(r),
+               (unsigned long)rate_meter_jitter_us(r), (unsigned long)r->max_us,
+               (unsigned long)r->gaps, (unsigned long)r->missed);
+        printf("  dispatch  itf %u: mouse=%lu, errors=%lu, filtered unknown id=%lu, keyboard=%lu, other=%lu\n",
+               d.instance, (unsigned long)d.reports, (unsigned long)d.errors,
+               (unsigned long)d.filtered[HID_ROUTE_NONE], (unsigned long)d.filtered[HID_ROUTE_KEYBOARD],
+               (unsigned long)d.filtered[HID_ROUTE_OTHER]);
+    }
+    if (realtime) latency_print();   // nur in Echtzeit aussagekräftig
+    return conserved;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool realtime = false;
+    int  files    = 0;
+    bool ok       = true;
+
+    tusb_init();
+    msx_output_init(MSX_READ_LIMIT);
+    msx_buttons_init();
+    trace_set_live(false);
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--realtime")) {
+            realtime = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "--profile") && i + 1 < argc) {
+            char const* name = argv[++i];
+            int p = 0;
+            while (p < BALLISTICS_PROFILE_COUNT && strcmp(name, ballistics_profile_name((ballistics_profile_t)p))) p++;
+            if (p == BALLISTICS_PROFILE_COUNT) {
+                fprintf(stderr, "unknown profile: %s\n", name);
+                return 2;
+            }
+            ballistics_set_profile((ballistics_profile_t)p);
+            continue;
+        }
+        corpus_t c;
+        std::string error;
+        if (!corpus_load(argv[i], &c, &error)) {
+            fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+            return 2;
+        }
+        ok = replay(c, realtime) && ok;
+        files++;
+    }
+
+    if (!files) {
+        fprintf(stderr, "usage: %s [--realtime] [--profile linear|windows|s-curve] <corpus.hidr>...\n", argv[0]);
+        return 2;
+    }
+    return ok ? 0 : 1;
+}
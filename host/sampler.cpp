@@ -0,0 +1,421 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+#include "host_usb.h"
+#include "msx_buttons.h"
+#include "msx_host.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+#include "pin_masks.h"
+#include "pins.h"
+#include "trace.h"
+#include "z80.h"
+
+// -----------------------------------------------------------------------------
+// Sampler-Prüfstand: Z80 führt eine Maus-Leseroutine im Stil des MSX-BIOS aus
+//
+//   roland_host_sampler [--reads N] [--delay N] [--gap-us N] [--refill-ns N] [--vcd datei]
+//
+// Die Routine schaltet den Strobe über PSG-Register 15 und liest die Nibbles
+// aus Register 14, jeweils zum T-Zustand des I/O-Zugriffs. Gegenüber steht
+// das Host-Modell des PIO-Ausgangs (msx_output_host.cpp, mit Strobe-Watchdog
+// auf der virtuellen Uhr). Je Nibble wird geprüft, ob die State-Machine beim
+// Lesen schon geantwortet hatte:
+//
+//   Flanke -> Nibble    2 Takte Eingangssynchronisation, wait, out (125 MHz);
+//                       die erste Flanke trifft die Leerlaufschleife (bis zu
+//                       4 Befehle mehr)
+//   nach dem 4. Nibble  push + irq wait: erst nach dem IRQ-Handler (--refill-ns)
+//                       kann der nächste Lesezyklus beginnen
+//
+// Jeder SIO-Zugriff des Modells auf die Pins kostet SIO_WRITE_NS; schreibt
+// es ein Nibble in mehreren Zugriffen, steht das Nibble entsprechend später
+// vollständig an (Bit-Versatz). --vcd schreibt den Verlauf von Strobe, D0..D3
+// und Triggern als Waveform.
+//
+// --delay ist der Zähler der Warteschleife zwischen Strobe und Lesen (wie im
+// BIOS), --gap-us der Abstand der Lesevorgänge. Ausgabe: je Nibble Flanke und
+// Abtastung in T-Zuständen mit Reserve, am Ende die knappste Reserve. Exit-Code
+// 1, wenn ein Nibble zu früh gelesen wurde oder ein Wert nicht stimmt.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint16_t ROUTINE = 0x4000;
+constexpr uint16_t RESULT  = 0xC000;
+
+constexpr uint8_t PSG_ADDR  = 0xA0;
+constexpr uint8_t PSG_WRITE = 0xA1;
+constexpr uint8_t PSG_READ  = 0xA2;
+
+constexpr uint8_t R15_STROBE_A = 0x10;   // Pin 8 an Port A
+constexpr uint8_t R15_PORT_B   = 0x40;   // Register 14 liest Port B
+
+constexpr double PIO_NS          = 1000.0 / 125.0;
+constexpr double WAIT_RESPONSE_NS = 4 * PIO_NS;
+constexpr double IDLE_RESPONSE_NS = WAIT_RESPONSE_NS + 4 * PIO_NS;
+constexpr double SIO_WRITE_NS     = PIO_NS;   // untere Grenze: ein Systemtakt je Zugriff
+
+char const* const NIBBLE_NAME[MSX_NIBBLES_PER_READ] = { "X high", "X low", "Y high", "Y low" };
+
+// Ein Lesezyklus; Ergebnis: 4 Nibbles ab RESULT
+uint8_t const routine[] = {
+    0xF3,               //        di
+    0x3E, 0x0F,         //        ld   a,15
+    0xD3, PSG_ADDR,     //        out  (0xA0),a
+    0xDB, PSG_READ,     //        in   a,(0xA2)      ; R15 lesen
+    0xE6, 0xAF,         //        and  0xAF          ; Port A, Strobe low
+    0x4F,               //        ld   c,a
+    0x06, 0x04,         //        ld   b,4
+    0x21, 0x00, 0xC0,   //        ld   hl,RESULT
+    0x3E, 0x0F,         // loop:  ld   a,15
+    0xD3, PSG_ADDR,     //        out  (0xA0),a
+    0x79,               //        ld   a,c
+    0xEE, R15_STROBE_A, //        xor  0x10          ; Strobe wechseln
+    0x4F,               //        ld   c,a
+    0xD3, PSG_WRITE,    //        out  (0xA1),a
+    0x3E, 0x00,         //        ld   a,DELAY       ; wird gesetzt
+    0x3D,               // wait:  dec  a
+    0x20, 0xFD,         //        jr   nz,wait
+    0x3E, 0x0E,         //        ld   a,14
+    0xD3, PSG_ADDR,     //        out  (0xA0),a
+    0xDB, PSG_READ,     //        in   a,(0xA2)
+    0xE6, 0x0F,         //        and  0x0F
+    0x77,               //        ld   (hl),a
+    0x23,               //        inc  hl
+    0x10, 0xE5,         //        djnz loop
+    0xFB,               //        ei
+    0xC9,               //        ret
+};
+constexpr uint16_t DELAY_OFFSET = 26;   // Operand von "ld a,DELAY"
+
+struct sample_t {
+    uint32_t read;
+    uint32_t index;
+    uint64_t edge_t;
+    uint64_t sample_t;
+    double   margin_ns;   // Abtastung minus Zeitpunkt, ab dem das Nibble anlag
+    bool     valid;
+};
+
+struct bench_t {
+    uint8_t  psg_addr = 0;
+    uint8_t  r15      = 0;
+    bool     strobe   = false;
+
+    uint8_t  shown     = 0;    // Nibble vor der letzten Flanke
+    uint8_t  next      = 0;    // Nibble nach der letzten Flanke
+    double   valid_at  = 0;    // ab hier liegt next an
+    uint64_t edge_t    = 0;
+    uint32_t edge_index = 0;   // Flanken im laufenden Lesezyklus
+    double   refill_done = 0;  // IRQ-Handler nach dem letzten Lesezyklus fertig
+
+    uint32_t read = 0;
+    std::vector<sample_t> samples;
+};
+
+double t_to_ns(uint64_t t)
+{
+    return (double)t * 1e9 / Z80_MSX_CLOCK_HZ;
+}
+
+// -----------------------------------------------------------------------------
+// Waveform: SIO-Zugriffe des Modells je Ereignis (Strobe-Flanke), als VCD
+// -----------------------------------------------------------------------------
+struct wave_t {
+    FILE*    vcd = nullptr;
+    double   last_ns = 0;
+    uint32_t levels  = 0;
+    bool     strobe  = false;
+
+    double   base_ns     = 0;   // Beginn des laufenden Ereignisses
+    uint32_t writes      = 0;   // SIO-Zugriffe seit Ereignisbeginn
+    int32_t  first_data  = -1;  // Index des ersten/letzten Zugriffs auf D0..D3
+    int32_t  last_data   = -1;
+
+    uint32_t max_data_writes = 0;
+    double   max_skew_ns     = 0;
+};
+
+wave_t wave;
+
+struct vcd_signal_t {
+    char     id;
+    char const* name;
+    uint32_t mask;
+};
+
+vcd_signal_t const vcd_signals[] = {
+    { '0', "d0",     1u << PIN_MSX_D0 },
+    { '1', "d1",     1u << PIN_MSX_D1 },
+    { '2', "d2",     1u << PIN_MSX_D2 },
+    { '3', "d3",     1u << PIN_MSX_D3 },
+    { 'a', "trig_a", 1u << PIN_MSX_TRIG_A },
+    { 'b', "trig_b", 1u << PIN_MSX_TRIG_B },
+};
+
+void vcd_time(double ns)
+{
+    wave.last_ns = std::max(wave.last_ns, ns);
+    fprintf(wave.vcd, "#%llu\n", (unsigned long long)(wave.last_ns + 0.5));
+}
+
+void vcd_open(char const* path, uint32_t levels)
+{
+    wave.vcd = fopen(path, "w");
+    if (!wave.vcd) return;
+    fprintf(wave.vcd, "$timescale 1ns $end\n$scope module msx $end\n$var wire 1 s strobe $end\n");
+    for (vcd_signal_t const& s : vcd_signals) fprintf(wave.vcd, "$var wire 1 %c %s $end\n", s.id, s.name);
+    fprintf(wave.vcd, "$upscope $end\n$enddefinitions $end\n#0\n0s\n");
+    for (vcd_signal_t const& s : vcd_signals) fprintf(wave.vcd, "%d%c\n", (levels & s.mask) ? 1 : 0, s.id);
+}
+
+void vcd_strobe(double ns, bool level)
+{
+    if (!wave.vcd) return;
+    vcd_time(ns);
+    fprintf(wave.vcd, "%ds\n", level ? 1 : 0);
+}
+
+void wave_event_end(void)
+{
+    if (wave.first_data < 0) return;
+    uint32_t const n = (uint32_t)(wave.last_data - wave.first_data + 1);
+    wave.max_data_writes = std::max(wave.max_data_writes, n);
+    wave.max_skew_ns     = std::max(wave.max_skew_ns, (n - 1) * SIO_WRITE_NS);
+}
+
+void wave_event_begin(double ns)
+{
+    wave_event_end();
+    wave.base_ns    = ns;
+    wave.writes     = 0;
+    wave.first_data = -1;
+    wave.last_data  = -1;
+}
+
+// Nachbildung eines SIO-Zugriffs (host_gpio_set_hook)
+void wave_gpio(uint32_t mask, uint32_t levels)
+{
+    double const ns = wave.base_ns + wave.writes * SIO_WRITE_NS;
+    if (mask & MSX_DATA_MASK) {
+        if (wave.first_data < 0) wave.first_data = (int32_t)wave.writes;
+        wave.last_data = (int32_t)wave.writes;
+    }
+    wave.writes++;
+
+    uint32_t const changed = (levels ^ wave.levels) & mask;
+    wave.levels = levels;
+    if (!wave.vcd || !changed) return;
+    vcd_time(ns);
+    for (vcd_signal_t const& s : vcd_signals) {
+        if (changed & s.mask) fprintf(wave.vcd, "%d%c\n", (levels & s.mask) ? 1 : 0, s.id);
+    }
+}
+
+uint8_t visible(bench_t const* b, double ns)
+{
+    return ns >= b->valid_at ? b->next : b->shown;
+}
+
+void strobe_edge(bench_t* b, bool level, uint64_t t)
+{
+    double const ns = t_to_ns(t);
+    host_time_set((uint64_t)(ns / 1000.0));   // Watchdog auf derselben Uhr
+
+    b->shown  = visible(b, ns);
+    b->edge_t = t;
+
+    uint32_t const index = b->edge_index++;
+    if (index == 0) {
+        b->valid_at = std::max(ns, b->refill_done) + IDLE_RESPONSE_NS;
+    } else {
+        b->valid_at = ns + WAIT_RESPONSE_NS;
+    }
+    b->strobe = level;
+
+    // Pins schalten ab valid_at; jeder weitere SIO-Zugriff verschiebt das
+    // vollständige Nibble um SIO_WRITE_NS
+    vcd_strobe(ns, level);
+    wave_event_begin(b->valid_at);
+    b->next = msx_host_strobe(level);
+    if (wave.last_data > 0) b->valid_at += wave.last_data * SIO_WRITE_NS;
+}
+
+void psg_out(void* ctx, uint8_t port, uint8_t value, uint64_t t)
+{
+    bench_t* b = (bench_t*)ctx;
+    if (port == PSG_ADDR) {
+        b->psg_addr = value & 0x0F;
+        return;
+    }
+    if (port != PSG_WRITE || b->psg_addr != 15) return;
+
+    b->r15 = value;
+    bool const level = (value & R15_STROBE_A) != 0;
+    if (level != b->strobe) strobe_edge(b, level, t);
+}
+
+uint8_t psg_in(void* ctx, uint8_t port, uint64_t t)
+{
+    bench_t* b = (bench_t*)ctx;
+    if (port != PSG_READ) return 0xFF;
+    if (b->psg_addr == 15) return b->r15;
+    if (b->psg_addr != 14 || (b->r15 & R15_PORT_B)) return 0xFF;
+
+    double const ns = t_to_ns(t);
+    sample_t s;
+    s.read      = b->read;
+    s.index     = b->edge_index - 1;
+    s.edge_t    = b->edge_t;
+    s.sample_t  = t;
+    s.margin_ns = ns - b->valid_at;
+    s.valid     = s.margin_ns >= 0;
+    b->samples.push_back(s);
+
+    uint8_t triggers = 0;
+    if (gpio_get(PIN_MSX_TRIG_A)) triggers |= 0x10;
+    if (gpio_get(PIN_MSX_TRIG_B)) triggers |= 0x20;
+    return (uint8_t)(0xC0 | triggers | visible(b, ns));
+}
+
+long arg_value(int argc, char** argv, int* i, long lo, long hi)
+{
+    if (*i + 1 >= argc) return lo - 1;
+    long v = strtol(argv[++*i], nullptr, 10);
+    return (v < lo || v > hi) ? lo - 1 : v;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long reads     = 4;
+    long delay     = 4;
+    long gap_us    = 16667;    // 60 Hz
+    long refill_ns = 2000;
+    char const* vcd_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--vcd") && i + 1 < argc) {
+            vcd_path = argv[++i];
+            continue;
+        }
+        long* opt = nullptr;
+        long  lo = 1, hi = 0;
+        if      (!strcmp(argv[i], "--reads"))     { opt = &reads;     hi = 100000; }
+        else if (!strcmp(argv[i], "--delay"))     { opt = &delay;     hi = 255; }
+        else if (!strcmp(argv[i], "--gap-us"))    { opt = &gap_us;    lo = 0; hi = 1000000; }
+        else if (!strcmp(argv[i], "--refill-ns")) { opt = &refill_ns; lo = 0; hi = 1000000; }
+        if (opt) *opt = arg_value(argc, argv, &i, lo, hi);
+        if (!opt || *opt < lo) {
+            fprintf(stderr, "usage: %s [--reads N] [--delay 1..255] [--gap-us N] [--refill-ns N] [--vcd file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    tusb_init();
+    trace_set_live(false);
+    host_time_set(0);
+    msx_output_init(MSX_READ_LIMIT);
+    msx_buttons_init();
+
+    wave.levels = host_gpio_state();
+    if (vcd_path) {
+        vcd_open(vcd_path, wave.levels);
+        if (!wave.vcd) {
+            fprintf(stderr, "%s: cannot write\n", vcd_path);
+            return 2;
+        }
+    }
+    host_gpio_set_hook(wave_gpio);
+
+    static z80_t cpu;
+    static bench_t bench;
+    cpu.in     = psg_in;
+    cpu.out    = psg_out;
+    cpu.io_ctx = &bench;
+    z80_reset(&cpu);
+    memcpy(&cpu.mem[ROUTINE], routine, sizeof(routine));
+    cpu.mem[ROUTINE + DELAY_OFFSET] = (uint8_t)delay;
+
+    uint32_t const resyncs_before = msx_output_resync_count();
+    uint32_t wrong_values = 0;
+    uint64_t longest_edge_gap = 0;
+
+    for (long r = 0; r < reads; r++) {
+        // Bewegung vor jedem Lesen, innerhalb von +-127: ein Lesen holt alles ab
+        int32_t const dx = (int32_t)((r * 53) % 201) - 100;
+        int32_t const dy = (int32_t)((r * 29) % 161) - 80;
+        msx_output_add_motion(dx, dy, 0);
+
+        bench.read       = (uint32_t)r;
+        bench.edge_index = 0;
+        size_t const first = bench.samples.size();
+        if (!z80_call(&cpu, ROUTINE)) {
+            fprintf(stderr, "z80: unknown opcode %02X at %04X\n", cpu.bad_opcode, cpu.pc);
+            return 2;
+        }
+        if (bench.edge_index == MSX_NIBBLES_PER_READ) {
+            bench.refill_done = bench.valid_at + (double)refill_ns;
+        }
+
+        uint8_t const* n = &cpu.mem[RESULT];
+        int8_t const x = (int8_t)((n[0] << 4) | n[1]);
+        int8_t const y = (int8_t)((n[2] << 4) | n[3]);
+        bool const match = x == -dx && y == -dy;   // MSX-Richtung
+        if (!match) wrong_values++;
+
+        for (size_t i = first; i < bench.samples.size(); i++) {
+            sample_t const& s = bench.samples[i];
+            if (i > first) longest_edge_gap = std::max(longest_edge_gap, s.edge_t - bench.samples[i - 1].edge_t);
+            printf("read %3lu nibble %lu %-6s  edge T=%9llu  sample T=%9llu (+%4llu T)  margin %9.1f ns  %s\n",
+                   (unsigned long)s.read, (unsigned long)s.index,
+                   s.index < MSX_NIBBLES_PER_READ ? NIBBLE_NAME[s.index] : "?",
+                   (unsigned long long)s.edge_t, (unsigned long long)s.sample_t,
+                   (unsigned long long)(s.sample_t - s.edge_t), s.margin_ns, s.valid ? "ok" : "TOO EARLY");
+        }
+        printf("read %3lu -> (%d,%d), expected (%d,%d) %s\n", (unsigned long)r, x, y,
+               (int)-dx, (int)-dy, match ? "ok" : "WRONG");
+
+        // Sampler wartet bis zum nächsten Lesen
+        cpu.t += (uint64_t)gap_us * Z80_MSX_CLOCK_HZ / 1000000;
+        host_time_set((uint64_t)(t_to_ns(cpu.t) / 1000.0));
+    }
+
+    double   min_margin   = 1e18;
+    uint64_t min_response = UINT64_MAX;
+    uint32_t too_early    = 0;
+    for (sample_t const& s : bench.samples) {
+        min_margin   = std::min(min_margin, s.margin_ns);
+        min_response = std::min(min_response, s.sample_t - s.edge_t);
+        if (!s.valid) too_early++;
+    }
+
+    printf("\nZ80 %.6f MHz (1 M1 wait), delay=%ld, %ld reads, gap %ld us, refill %ld ns\n",
+           Z80_MSX_CLOCK_HZ / 1e6, delay, reads, gap_us, refill_ns);
+    printf("nibbles: %lu sampled, %lu too early, tightest margin %.1f ns\n",
+           (unsigned long)bench.samples.size(), (unsigned long)too_early, min_margin);
+    printf("edge -> sample at least %llu T = %.1f ns: the firmware may take that long to answer a strobe edge\n",
+           (unsigned long long)min_response, t_to_ns(min_response));
+    printf("longest edge gap %.1f us (watchdog window %u us), resyncs %lu\n",
+           t_to_ns(longest_edge_gap) / 1000.0, (unsigned)ROLAND_MSX_STROBE_TIMEOUT_US,
+           (unsigned long)(msx_output_resync_count() - resyncs_before));
+    if (t_to_ns(longest_edge_gap) >= ROLAND_MSX_STROBE_TIMEOUT_US * 1000.0) {
+        printf("warning: edge gaps beyond the window can be cut short by the watchdog (after 1-2 windows)\n");
+    }
+    wave_event_end();
+    host_gpio_set_hook(nullptr);
+    printf("data lines: at most %lu SIO write(s) per nibble, skew %.1f ns\n",
+           (unsigned long)wave.max_data_writes, wave.max_skew_ns);
+    printf("values: %lu/%ld reads correct\n", (unsigned long)(reads - wrong_values), reads);
+    if (wave.vcd) fclose(wave.vcd);
+
+    return (too_early || wrong_values) ? 1 : 0;
+}
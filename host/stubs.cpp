@@ -0,0 +1,407 @@
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/structs/scb.h"
+#include "hardware/uart.h"
+#include "bsp/board.h"
+#include "tusb.h"
+
+#include "host_usb.h"
+
+// -----------------------------------------------------------------------------
+// Dünne Nachbildung von pico-sdk und TinyUSB für den Host-Build
+// -----------------------------------------------------------------------------
+
+#define HOST_DEV_MAX (CFG_TUH_DEVICE_MAX + CFG_TUH_HUB)
+
+armv6m_scb_hw_t host_scb;
+
+static struct {
+    uint16_t vid;
+    uint16_t pid;
+    uint8_t  itf_protocol[CFG_TUH_HID];
+    uint8_t  protocol[CFG_TUH_HID];
+    uint8_t  interval_ms[CFG_TUH_HID];
+} devices[HOST_DEV_MAX];
+
+static uint32_t receive_count;
+static uint32_t set_idle_count;
+static uint32_t         gpio_out;
+static host_gpio_hook_t gpio_hook;
+
+// --- Zeit --------------------------------------------------------------------
+
+static bool     virtual_time;
+static uint64_t virtual_us;
+
+#define HOST_TIMER_MAX 4
+static repeating_timer_t* timers[HOST_TIMER_MAX];
+
+uint64_t time_us_64(void)
+{
+    if (virtual_time) return virtual_us;
+    static auto const start = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64_t period_of(repeating_timer_t const* t)
+{
+    return (uint64_t)(t->delay_us < 0 ? -t->delay_us : t->delay_us);
+}
+
+void host_time_set(uint64_t us)
+{
+    if (!virtual_time || us < virtual_us) {
+        // Uhr springt (neuer Korpus): Timer ab jetzt neu takten
+        for (repeating_timer_t* t : timers) {
+            if (t) t->host_due_us = us + period_of(t);
+        }
+    }
+    virtual_time = true;
+
+    // Fällige Timer in zeitlicher Reihenfolge auslösen
+    while (true) {
+        repeating_timer_t* next = nullptr;
+        for (repeating_timer_t* t : timers) {
+            if (t && t->host_due_us <= us && (!next || t->host_due_us < next->host_due_us)) next = t;
+        }
+        if (!next) break;
+        virtual_us = next->host_due_us;
+        next->host_due_us += period_of(next);
+        if (!next->callback(next)) cancel_repeating_timer(next);
+    }
+    virtual_us = us;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out)
+{
+    for (repeating_timer_t*& t : timers) {
+        if (t) continue;
+        out->delay_us    = delay_us;
+        out->callback    = callback;
+        out->user_data   = user_data;
+        out->host_due_us = time_us_64() + period_of(out);
+        t = out;
+        return true;
+    }
+    return false;
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer)
+{
+    for (repeating_timer_t*& t : timers) {
+        if (t == timer) {
+            t = nullptr;
+            return true;
+        }
+    }
+    return false;
+}
+
+void host_time_real(void)
+{
+    virtual_time = false;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+void sleep_us(uint64_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us(1000ull * ms);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout)
+{
+    (void) timeout;
+    return false;
+}
+
+// --- stdio / UART ------------------------------------------------------------
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    (void) timeout_us;
+    return PICO_ERROR_TIMEOUT;
+}
+
+bool uart_is_writable(uart_inst_t* uart)
+{
+    (void) uart;
+    return true;
+}
+
+void uart_putc_raw(uart_inst_t* uart, char c)
+{
+    (void) uart;
+    putchar(c);
+}
+
+void board_init(void)
+{
+}
+
+// --- GPIO --------------------------------------------------------------------
+
+static void gpio_written(uint32_t mask)
+{
+    if (gpio_hook) gpio_hook(mask, gpio_out);
+}
+
+void host_gpio_set_hook(host_gpio_hook_t hook)
+{
+    gpio_hook = hook;
+}
+
+void gpio_init(uint gpio)
+{
+    gpio_out &= ~(1u << gpio);
+    gpio_written(1u << gpio);
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    (void) gpio;
+    (void) out;
+}
+
+void gpio_put(uint gpio, bool value)
+{
+    if (value) gpio_out |=  (1u << gpio);
+    else       gpio_out &= ~(1u << gpio);
+    gpio_written(1u << gpio);
+}
+
+void gpio_put_masked(uint32_t mask, uint32_t value)
+{
+    gpio_out = (gpio_out & ~mask) | (value & mask);
+    gpio_written(mask);
+}
+
+bool gpio_get(uint gpio)
+{
+    return (gpio_out >> gpio) & 1u;
+}
+
+uint32_t gpio_get_all(void)
+{
+    return gpio_out;
+}
+
+uint32_t host_gpio_state(void)
+{
+    return gpio_out;
+}
+
+// --- Flash -------------------------------------------------------------------
+
+uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+
+static uint32_t flash_erases;
+static uint32_t flash_programs;
+static int32_t  flash_tear = -1;   // nächstes Programmieren nach so vielen Bytes abbrechen
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    memset(&host_flash[flash_offs], 0xFF, count);
+    flash_erases++;
+}
+
+void flash_range_program(uint32_t flash_offs, uint8_t const* data, size_t count)
+{
+    if (flash_tear >= 0 && (size_t)flash_tear < count) count = (size_t)flash_tear;
+    flash_tear = -1;
+    for (size_t i = 0; i < count; i++) host_flash[flash_offs + i] &= data[i];
+    flash_programs++;
+}
+
+void host_flash_reset(void)
+{
+    memset(host_flash, 0xFF, sizeof(host_flash));
+    flash_erases   = 0;
+    flash_programs = 0;
+    flash_tear     = -1;
+}
+
+void host_flash_tear_next_program(uint32_t bytes)
+{
+    flash_tear = (int32_t)bytes;
+}
+
+uint32_t host_flash_erase_count(void)
+{
+    return flash_erases;
+}
+
+uint32_t host_flash_program_count(void)
+{
+    return flash_programs;
+}
+
+// --- TinyUSB -----------------------------------------------------------------
+
+bool tusb_init(void)
+{
+    return true;
+}
+
+void tuh_task(void)
+{
+}
+
+bool tuh_task_event_ready(void)
+{
+    return false;
+}
+
+bool tuh_vid_pid_get(uint8_t dev_addr, uint16_t* vid, uint16_t* pid)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX) return false;
+    *vid = devices[dev_addr - 1].vid;
+    *pid = devices[dev_addr - 1].pid;
+    return true;
+}
+
+uint8_t tuh_hid_interface_protocol(uint8_t dev_addr, uint8_t idx)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || idx >= CFG_TUH_HID) return HID_ITF_PROTOCOL_NONE;
+    return devices[dev_addr - 1].itf_protocol[idx];
+}
+
+uint8_t tuh_hid_get_protocol(uint8_t dev_addr, uint8_t idx)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || idx >= CFG_TUH_HID) return HID_PROTOCOL_REPORT;
+    return devices[dev_addr - 1].protocol[idx];
+}
+
+bool tuh_hid_receive_report(uint8_t dev_addr, uint8_t idx)
+{
+    (void) dev_addr;
+    (void) idx;
+    receive_count++;
+    return true;
+}
+
+void tuh_hid_set_default_protocol(uint8_t protocol)
+{
+    (void) protocol;
+}
+
+// Wie ein Gerät, das jeden Wechsel annimmt; Abschluss sofort statt aus tuh_task()
+bool tuh_hid_set_protocol(uint8_t dev_addr, uint8_t idx, uint8_t protocol)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || idx >= CFG_TUH_HID) return false;
+    if (devices[dev_addr - 1].itf_protocol[idx] == HID_ITF_PROTOCOL_NONE) return false;
+    devices[dev_addr - 1].protocol[idx] = protocol;
+    tuh_hid_set_protocol_complete_cb(dev_addr, idx, protocol);
+    return true;
+}
+
+bool tuh_hid_itf_get_info(uint8_t dev_addr, uint8_t idx, tuh_itf_info_t* itf_info)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || idx >= CFG_TUH_HID) return false;
+    *itf_info = tuh_itf_info_t{};
+    itf_info->daddr                   = dev_addr;
+    itf_info->desc.bInterfaceNumber   = idx;
+    itf_info->desc.bInterfaceClass    = 3;
+    itf_info->desc.bInterfaceProtocol = devices[dev_addr - 1].itf_protocol[idx];
+    return true;
+}
+
+bool tuh_control_xfer(tuh_xfer_t* xfer)
+{
+    if (xfer->setup->bRequest == HID_REQ_CONTROL_SET_IDLE) set_idle_count++;
+    xfer->result     = XFER_RESULT_SUCCESS;
+    xfer->actual_len = 0;
+    if (xfer->complete_cb) xfer->complete_cb(xfer);
+    return true;
+}
+
+// Konfiguration mit einem HID-Interface je Instanz (Interface-Nummer = Instanz)
+bool tuh_descriptor_get_configuration(uint8_t daddr, uint8_t index, void* buffer, uint16_t len,
+                                      tuh_xfer_cb_t complete_cb, uintptr_t user_data)
+{
+    (void) index;
+    if (daddr == 0 || daddr > HOST_DEV_MAX) return false;
+
+    uint8_t desc[9 + CFG_TUH_HID * (9 + 9 + 7)];
+    uint16_t n = 9;
+    uint8_t  itfs = 0;
+    for (uint8_t i = 0; i < CFG_TUH_HID; i++) {
+        uint8_t const proto = devices[daddr - 1].itf_protocol[i];
+        uint8_t const itf[]  = { 9, TUSB_DESC_INTERFACE, i, 0, 1, 3, (uint8_t)(proto ? 1 : 0), proto, 0 };
+        uint8_t const hid[]  = { 9, HID_DESC_TYPE_HID, 0x11, 0x01, 0, 1, 0x22, 0, 0 };
+        uint8_t const ep[]   = { 7, TUSB_DESC_ENDPOINT, (uint8_t)(0x81 + i), TUSB_XFER_INTERRUPT, 8, 0,
+                                 devices[daddr - 1].interval_ms[i] };
+        memcpy(&desc[n], itf, sizeof(itf)); n += sizeof(itf);
+        memcpy(&desc[n], hid, sizeof(hid)); n += sizeof(hid);
+        memcpy(&desc[n], ep, sizeof(ep));   n += sizeof(ep);
+        itfs++;
+    }
+    uint8_t const cfg[] = { 9, TUSB_DESC_CONFIGURATION, (uint8_t)n, (uint8_t)(n >> 8), itfs, 1, 0, 0x80, 50 };
+    memcpy(desc, cfg, sizeof(cfg));
+
+    uint16_t const actual = n < len ? n : len;
+    memcpy(buffer, desc, actual);
+
+    tusb_control_request_t setup = {};
+    tuh_xfer_t xfer = {};
+    xfer.daddr       = daddr;
+    xfer.result      = XFER_RESULT_SUCCESS;
+    xfer.actual_len  = actual;
+    xfer.setup       = &setup;
+    xfer.buffer      = (uint8_t*)buffer;
+    xfer.complete_cb = complete_cb;
+    xfer.user_data   = user_data;
+    if (complete_cb) complete_cb(&xfer);
+    return true;
+}
+
+void host_usb_set_device(uint8_t dev_addr, uint16_t vid, uint16_t pid)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX) return;
+    devices[dev_addr - 1].vid = vid;
+    devices[dev_addr - 1].pid = pid;
+}
+
+void host_usb_set_protocol(uint8_t dev_addr, uint8_t instance,
+                           uint8_t itf_protocol, uint8_t protocol)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || instance >= CFG_TUH_HID) return;
+    devices[dev_addr - 1].itf_protocol[instance] = itf_protocol;
+    devices[dev_addr - 1].protocol[instance]     = protocol;
+}
+
+void host_usb_set_interval(uint8_t dev_addr, uint8_t instance, uint8_t interval_ms)
+{
+    if (dev_addr == 0 || dev_addr > HOST_DEV_MAX || instance >= CFG_TUH_HID) return;
+    devices[dev_addr - 1].interval_ms[instance] = interval_ms;
+}
+
+uint32_t host_usb_receive_count(void)
+{
+    return receive_count;
+}
+
+uint32_t host_usb_set_idle_count(void)
+{
+    return set_idle_count;
+}
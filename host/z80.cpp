@@ -0,0 +1,157 @@
+#include <string.h>
+
+#include "z80.h"
+
+// MSX: ein Wartezyklus je M1 (Opcode-Holen)
+#define M1_WAIT 1
+
+#define FLAG_C  0x01
+#define FLAG_N  0x02
+#define FLAG_PV 0x04
+#define FLAG_H  0x10
+#define FLAG_Z  0x40
+#define FLAG_S  0x80
+
+// Zugriffszeitpunkt innerhalb des I/O-Maschinenzyklus (T1 T2 TW T3):
+// OUT übernimmt der Baustein mit dem Ende von /WR nach T3, IN liest in T3
+#define OUT_AT(len) (len)
+#define IN_AT(len)  ((len) - 1)
+
+namespace {
+
+uint8_t fetch(z80_t* cpu)
+{
+    return cpu->mem[cpu->pc++];
+}
+
+uint16_t fetch16(z80_t* cpu)
+{
+    uint8_t lo = fetch(cpu);
+    uint8_t hi = fetch(cpu);
+    return (uint16_t)(lo | (hi << 8));
+}
+
+bool parity_even(uint8_t v)
+{
+    v ^= v >> 4;
+    v ^= v >> 2;
+    v ^= v >> 1;
+    return !(v & 1);
+}
+
+uint8_t logic_flags(uint8_t v, uint8_t extra)
+{
+    return (uint8_t)((v & FLAG_S) | (v ? 0 : FLAG_Z) | (parity_even(v) ? FLAG_PV : 0) | extra);
+}
+
+uint8_t dec8(z80_t* cpu, uint8_t v)
+{
+    uint8_t r = (uint8_t)(v - 1);
+    uint8_t f = (uint8_t)((cpu->f & FLAG_C) | FLAG_N | (r & FLAG_S) | (r ? 0 : FLAG_Z));
+    if ((v & 0x0F) == 0) f |= FLAG_H;
+    if (v == 0x80) f |= FLAG_PV;
+    cpu->f = f;
+    return r;
+}
+
+} // namespace
+
+void z80_reset(z80_t* cpu)
+{
+    z80_in_fn  in  = cpu->in;
+    z80_out_fn out = cpu->out;
+    void*      ctx = cpu->io_ctx;
+    memset(cpu, 0, sizeof(*cpu));
+    cpu->in     = in;
+    cpu->out    = out;
+    cpu->io_ctx = ctx;
+    cpu->sp     = 0xF000;
+}
+
+bool z80_step(z80_t* cpu)
+{
+    if (cpu->halted) return false;
+
+    uint8_t const op = fetch(cpu);
+    uint32_t len;
+
+    switch (op) {
+    case 0x00: len = 4; break;                                        // NOP
+    case 0x76: len = 4; cpu->halted = true; cpu->pc--; break;         // HALT
+    case 0xF3: len = 4; cpu->iff = false; break;                      // DI
+    case 0xFB: len = 4; cpu->iff = true; break;                       // EI
+
+    case 0x06: len = 7; cpu->b = fetch(cpu); break;                   // LD B,n
+    case 0x0E: len = 7; cpu->c = fetch(cpu); break;                   // LD C,n
+    case 0x3E: len = 7; cpu->a = fetch(cpu); break;                   // LD A,n
+    case 0x4F: len = 4; cpu->c = cpu->a; break;                       // LD C,A
+    case 0x79: len = 4; cpu->a = cpu->c; break;                       // LD A,C
+    case 0x21: len = 10; { uint16_t v = fetch16(cpu); cpu->h = (uint8_t)(v >> 8); cpu->l = (uint8_t)v; } break; // LD HL,nn
+    case 0x77: len = 7; cpu->mem[(cpu->h << 8) | cpu->l] = cpu->a; break;   // LD (HL),A
+    case 0x23: len = 6; { uint16_t v = (uint16_t)(((cpu->h << 8) | cpu->l) + 1); cpu->h = (uint8_t)(v >> 8); cpu->l = (uint8_t)v; } break; // INC HL
+
+    case 0x3D: len = 4; cpu->a = dec8(cpu, cpu->a); break;            // DEC A
+    case 0xE6: len = 7; cpu->a &= fetch(cpu); cpu->f = logic_flags(cpu->a, FLAG_H); break;  // AND n
+    case 0xEE: len = 7; cpu->a ^= fetch(cpu); cpu->f = logic_flags(cpu->a, 0); break;       // XOR n
+
+    case 0x20: {                                                      // JR NZ,e
+        int8_t e = (int8_t)fetch(cpu);
+        len = 7;
+        if (!(cpu->f & FLAG_Z)) {
+            cpu->pc = (uint16_t)(cpu->pc + e);
+            len = 12;
+        }
+        break;
+    }
+    case 0x10: {                                                      // DJNZ e
+        int8_t e = (int8_t)fetch(cpu);
+        len = 8;
+        if (--cpu->b) {
+            cpu->pc = (uint16_t)(cpu->pc + e);
+            len = 13;
+        }
+        break;
+    }
+    case 0xC9:                                                        // RET
+        len = 10;
+        cpu->pc = (uint16_t)(cpu->mem[cpu->sp] | (cpu->mem[(uint16_t)(cpu->sp + 1)] << 8));
+        cpu->sp = (uint16_t)(cpu->sp + 2);
+        break;
+
+    case 0xD3: {                                                      // OUT (n),A
+        uint8_t port = fetch(cpu);
+        len = 11;
+        cpu->out(cpu->io_ctx, port, cpu->a, cpu->t + OUT_AT(len + M1_WAIT));
+        break;
+    }
+    case 0xDB: {                                                      // IN A,(n)
+        uint8_t port = fetch(cpu);
+        len = 11;
+        cpu->a = cpu->in(cpu->io_ctx, port, cpu->t + IN_AT(len + M1_WAIT));
+        break;
+    }
+
+    default:
+        cpu->pc--;
+        cpu->bad_opcode = op;
+        cpu->halted     = true;
+        return false;
+    }
+
+    cpu->t += len + M1_WAIT;
+    return !cpu->halted;
+}
+
+bool z80_call(z80_t* cpu, uint16_t addr)
+{
+    // Rücksprung auf ein HALT an Adresse 0
+    cpu->mem[0] = 0x76;
+    cpu->sp = (uint16_t)(cpu->sp - 2);
+    cpu->mem[cpu->sp] = 0x00;
+    cpu->mem[(uint16_t)(cpu->sp + 1)] = 0x00;
+    cpu->pc     = addr;
+    cpu->halted = false;
+
+    while (z80_step(cpu)) {}
+    return cpu->pc == 0 && !cpu->bad_opcode;
+}
@@ -0,0 +1,46 @@
+#ifndef _Z80_H_
+#define _Z80_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Z80-Kern für den Sampler-Prüfstand (host/sampler.cpp)
+//
+// Nur die Befehle, die eine Maus-Leseroutine im Stil des MSX-BIOS braucht;
+// ein unbekannter Opcode hält die CPU an. Takte nach Zilog-Tabelle plus dem
+// Wartezyklus, den das MSX in jeden M1-Zyklus einfügt. I/O-Zugriffe melden
+// den T-Zustand, in dem sie am Bus wirksam werden.
+// -----------------------------------------------------------------------------
+
+#define Z80_MSX_CLOCK_HZ 3579545
+
+typedef struct z80 z80_t;
+
+// t = T-Zustand des Zugriffs seit Start
+typedef uint8_t (*z80_in_fn)(void* ctx, uint8_t port, uint64_t t);
+typedef void    (*z80_out_fn)(void* ctx, uint8_t port, uint8_t value, uint64_t t);
+
+struct z80 {
+    uint8_t  a, f, b, c, d, e, h, l;
+    uint16_t sp, pc;
+    bool     iff;
+    bool     halted;
+    uint8_t  bad_opcode;   // gültig, wenn halted ohne HALT-Befehl
+
+    uint64_t t;            // T-Zustände seit Start
+    uint8_t  mem[65536];
+
+    z80_in_fn  in;
+    z80_out_fn out;
+    void*      io_ctx;
+};
+
+void z80_reset(z80_t* cpu);
+
+// Einen Befehl ausführen; false, wenn die CPU steht (HALT oder unbekannter Opcode)
+bool z80_step(z80_t* cpu);
+
+// Unterprogramm ab addr aufrufen, bis es zurückkehrt (Rücksprung auf ein HALT)
+bool z80_call(z80_t* cpu, uint16_t addr);
+
+#endif
@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <array>
+
+#include "ballistics.h"
+
+#ifndef ROLAND_BALLISTICS_PROFILE
+#define ROLAND_BALLISTICS_PROFILE 0
+#endif
+
+// Grundskalierung in Prozent (z. B. 50 für eine 1600-DPI-Maus)
+#ifndef ROLAND_BALLISTICS_SCALE
+#define ROLAND_BALLISTICS_SCALE 100
+#endif
+
+// Report-Intervall, auf das sich die Geschwindigkeitsachse der Tabellen bezieht
+#ifndef ROLAND_BALLISTICS_REF_INTERVAL_US
+#define ROLAND_BALLISTICS_REF_INTERVAL_US 8000
+#endif
+
+namespace {
+
+constexpr uint32_t SPEED_STEPS = 64;     // Index: |dx| + |dy| auf Bezugsrate, gesättigt
+constexpr uint32_t SPEED_SUM   = 4095;   // |dx| + |dy| davor begrenzt, damit mal speed_q8 in 32 Bit passt
+constexpr int32_t  MAX_COUNT   = 8191;   // größerer Eingang wird begrenzt ...
+constexpr uint32_t MAX_GAIN    = 4u << 16;   // ... damit d * Faktor in 32 Bit passt
+
+using table_t = std::array<uint32_t, SPEED_STEPS>;
+
+constexpr uint32_t to_q16(double gain)
+{
+    return (uint32_t)(gain * 65536.0 + 0.5);
+}
+
+struct knot_t {
+    double speed;
+    double gain;
+};
+
+// Stützstellen linear verbinden, über die letzte hinaus konstant
+template <size_t N>
+constexpr table_t piecewise(knot_t const (&k)[N])
+{
+    table_t t{};
+    for (uint32_t v = 0; v < SPEED_STEPS; v++) {
+        double g = k[N - 1].gain;
+        for (size_t i = 1; i < N; i++) {
+            if (v <= k[i].speed) {
+                double const f = (v - k[i - 1].speed) / (k[i].speed - k[i - 1].speed);
+                g = k[i - 1].gain + f * (k[i].gain - k[i - 1].gain);
+                break;
+            }
+        }
+        t[v] = to_q16(g);
+    }
+    return t;
+}
+
+constexpr table_t smoothstep(double lo, double hi, double from, double to)
+{
+    table_t t{};
+    for (uint32_t v = 0; v < SPEED_STEPS; v++) {
+        double x = (v - from) / (to - from);
+        if (x < 0) x = 0;
+        if (x > 1) x = 1;
+        t[v] = to_q16(lo + (hi - lo) * x * x * (3 - 2 * x));
+    }
+    return t;
+}
+
+constexpr knot_t linear_knots[]  = { {0, 1.0}, {1, 1.0} };
+constexpr knot_t windows_knots[] = { {0, 0.5}, {2, 0.75}, {6, 1.0}, {12, 1.5}, {24, 2.0} };
+
+constexpr table_t tables[BALLISTICS_PROFILE_COUNT] = {
+    piecewise(linear_knots),
+    piecewise(windows_knots),
+    smoothstep(0.5, 2.0, 2, 20),
+};
+
+// Profil mal Grundskalierung; die Skalierung ist je Profil so begrenzt
+// (scale_limit), dass kein Faktor MAX_GAIN erreicht
+constexpr table_t scaled(table_t const& t, uint32_t pct)
+{
+    table_t s{};
+    for (uint32_t v = 0; v < SPEED_STEPS; v++) s[v] = (uint32_t)((uint64_t)t[v] * pct / 100);
+    return s;
+}
+
+constexpr bool gains_fit(table_t const& t, uint32_t pct)
+{
+    for (uint32_t g : t) {
+        if ((uint64_t)g * pct / 100 >= MAX_GAIN) return false;
+    }
+    return true;
+}
+
+constexpr bool gains_fit(uint32_t pct)
+{
+    for (table_t const& t : tables) {
+        if (!gains_fit(t, pct)) return false;
+    }
+    return true;
+}
+static_assert((uint64_t)SPEED_SUM * (ROLAND_BALLISTICS_REF_INTERVAL_US * 256u / 125 + 1) <= UINT32_MAX,
+              "Index mal Ratenfaktor muss in 32 Bit passen");
+static_assert(gains_fit(ROLAND_BALLISTICS_SCALE), "ROLAND_BALLISTICS_SCALE zu groß: Faktor muss unter 4.0 bleiben");
+
+// Größte Skalierung je Profil, bei der die Kurve nicht abgeschnitten wird
+constexpr uint16_t max_scale(table_t const& t)
+{
+    uint16_t pct = BALLISTICS_SCALE_MAX;
+    while (!gains_fit(t, pct)) pct--;
+    return pct;
+}
+
+constexpr uint16_t scale_limit[BALLISTICS_PROFILE_COUNT] = {
+    max_scale(tables[BALLISTICS_LINEAR]),
+    max_scale(tables[BALLISTICS_WINDOWS]),
+    max_scale(tables[BALLISTICS_SCURVE]),
+};
+
+char const* const profile_names[] = { "linear", "windows", "s-curve" };
+char const* const invert_names[]  = { "-", "x", "y", "xy" };
+
+ballistics_profile_t profile   = (ballistics_profile_t)ROLAND_BALLISTICS_PROFILE;
+uint16_t             scale_pct = ROLAND_BALLISTICS_SCALE;
+uint8_t              invert;   // BALLISTICS_INVERT_*
+
+// Aktive Tabelle im RAM; der Startwert steht schon zur Compile-Zeit fest
+table_t gain = scaled(tables[ROLAND_BALLISTICS_PROFILE], ROLAND_BALLISTICS_SCALE);
+
+void rebuild(void)
+{
+    gain = scaled(tables[profile], scale_pct);
+}
+
+inline int32_t clamp_count(int32_t d)
+{
+    return d > MAX_COUNT ? MAX_COUNT : d < -MAX_COUNT ? -MAX_COUNT : d;
+}
+
+// Auf ganze Counts runden, Rest (Q16, -0.5 .. +0.5) behalten
+inline int32_t scale(int32_t d, uint32_t g, int32_t* rem)
+{
+    int32_t const q   = clamp_count(d) * (int32_t)g + *rem;
+    int32_t const out = (q + 0x8000) >> 16;
+    *rem = q - out * 65536;
+    return out;
+}
+
+} // namespace
+
+void ballistics_set_interval(ballistics_t* b, uint32_t interval_us)
+{
+    // Full/Low Speed: 1..255 ms, Faktor 2048..8 (Q8); kürzer als ein
+    // Microframe gibt es nicht
+    if (!interval_us) interval_us = ROLAND_BALLISTICS_REF_INTERVAL_US;
+    if (interval_us < 125) interval_us = 125;
+    b->speed_q8 = (ROLAND_BALLISTICS_REF_INTERVAL_US * 256u + interval_us / 2) / interval_us;
+}
+
+void ballistics_apply(ballistics_t* b, int32_t* dx, int32_t* dy)
+{
+    uint32_t v = (uint32_t)(*dx < 0 ? -*dx : *dx) + (uint32_t)(*dy < 0 ? -*dy : *dy);
+    if (v > SPEED_SUM) v = SPEED_SUM;
+    v = (v * b->speed_q8) >> 8;
+    if (v >= SPEED_STEPS) v = SPEED_STEPS - 1;
+    uint32_t const g = gain[v];
+
+    *dx = scale(*dx, g, &b->rem_x);
+    *dy = scale(*dy, g, &b->rem_y);
+    if (invert & BALLISTICS_INVERT_X) *dx = -*dx;
+    if (invert & BALLISTICS_INVERT_Y) *dy = -*dy;
+}
+
+void ballistics_set_profile(ballistics_profile_t p)
+{
+    if (p >= BALLISTICS_PROFILE_COUNT) return;
+    profile = p;
+    if (scale_pct > scale_limit[p]) scale_pct = scale_limit[p];
+    rebuild();
+}
+
+void ballistics_set_scale(uint16_t pct)
+{
+    if (pct < BALLISTICS_SCALE_MIN) pct = BALLISTICS_SCALE_MIN;
+    if (pct > scale_limit[profile]) pct = scale_limit[profile];
+    scale_pct = pct;
+    rebuild();
+}
+
+uint16_t ballistics_scale(void)
+{
+    return scale_pct;
+}
+
+uint16_t ballistics_scale_limit(void)
+{
+    return scale_limit[profile];
+}
+
+void ballistics_set_invert(uint8_t axes)
+{
+    invert = axes & (BALLISTICS_INVERT_X | BALLISTICS_INVERT_Y);
+}
+
+uint8_t ballistics_invert(void)
+{
+    return invert;
+}
+
+ballistics_profile_t ballistics_profile(void)
+{
+    return profile;
+}
+
+char const* ballistics_profile_name(ballistics_profile_t p)
+{
+    return profile_names[p];
+}
+
+void ballistics_print(void)
+{
+    printf("Ballistics[%s]: scale=%u%% (max %u%%), invert=%s, gain slow/mid/fast=%lu/%lu/%lu (Q16)\n",
+           profile_names[profile], (unsigned)scale_pct, (unsigned)scale_limit[profile], invert_names[invert],
+           (unsigned long)gain[1], (unsigned long)gain[8], (unsigned long)gain[SPEED_STEPS - 1]);
+}
@@ -0,0 +1,74 @@
+#ifndef _BALLISTICS_H_
+#define _BALLISTICS_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Zeigerballistik in Q16-Festkomma
+//
+// Je Report wird aus |dx| + |dy| ein Tabellenindex gebildet, umgerechnet
+// auf die Report-Rate ROLAND_BALLISTICS_REF_INTERVAL_US (125 Hz): eine Maus
+// mit 1000 Hz meldet je Report ein Achtel der Counts, ihr Index wird mit 8
+// multipliziert. Dieselbe Handbewegung trifft so bei jeder Rate denselben
+// Tabellenpunkt. Den Faktor setzt ballistics_set_interval() beim Mount aus
+// bInterval; ohne bInterval gilt die Bezugsrate. Die Tabelle
+// liefert den Faktor (Q16) für beide Achsen, darin ist die Grundskalierung
+// (Prozent, Start ROLAND_BALLISTICS_SCALE) schon enthalten. Pro Achse also
+// ein Tabellenzugriff und eine Multiplikation. Profil oder Skalierung zu
+// ändern baut die aktive Tabelle (64 Einträge im RAM) neu.
+//
+// Der Rest unter einem Count bleibt je Maus und Achse stehen und wird zum
+// nächsten Report addiert; langsame Bewegung geht so auch bei Faktoren < 1
+// nicht verloren. Die Tabellen entstehen zur Compile-Zeit:
+//
+//   linear    konstanter Faktor
+//   windows   stückweise linear wie "Zeigerbeschleunigung verbessern"
+//   s-curve   langsam fein, schnell grob, weicher Übergang (Smoothstep)
+// -----------------------------------------------------------------------------
+
+typedef enum {
+    BALLISTICS_LINEAR = 0,
+    BALLISTICS_WINDOWS,
+    BALLISTICS_SCURVE,
+    BALLISTICS_PROFILE_COUNT
+} ballistics_profile_t;
+
+#define BALLISTICS_SCALE_MIN 10
+#define BALLISTICS_SCALE_MAX 400
+
+// Achsen umkehren (nach der Skalierung)
+#define BALLISTICS_INVERT_X 0x01
+#define BALLISTICS_INVERT_Y 0x02
+
+// Zustand je Maus, liegt im Geräte-Pool
+typedef struct {
+    int32_t  rem_x;      // Rest in Q16, -0.5 .. +0.5 Count
+    int32_t  rem_y;
+    uint32_t speed_q8;   // Bezugs-Intervall / Report-Intervall, Q8
+} ballistics_t;
+
+// Report-Intervall der Maus (µs, 0 = unbekannt); vor dem ersten Report
+void ballistics_set_interval(ballistics_t* b, uint32_t interval_us);
+
+// Bewegung eines Reports skalieren (in place)
+void ballistics_apply(ballistics_t* b, int32_t* dx, int32_t* dy);
+
+void ballistics_set_profile(ballistics_profile_t p);
+ballistics_profile_t ballistics_profile(void);
+
+// Grundskalierung in Prozent, begrenzt auf BALLISTICS_SCALE_MIN bis
+// ballistics_scale_limit(): darüber würde der größte Faktor des Profils 4.0
+// erreichen und die Kurve abflachen. Ein Profilwechsel senkt die Skalierung
+// falls nötig auf die neue Grenze.
+void ballistics_set_scale(uint16_t pct);
+uint16_t ballistics_scale(void);
+uint16_t ballistics_scale_limit(void);
+
+// BALLISTICS_INVERT_X | BALLISTICS_INVERT_Y
+void ballistics_set_invert(uint8_t axes);
+uint8_t ballistics_invert(void);
+char const* ballistics_profile_name(ballistics_profile_t p);
+
+void ballistics_print(void);
+
+#endif
@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "boot_record.h"
+
+#ifndef ROLAND_FAST_START
+#define ROLAND_FAST_START 0
+#endif
+
+static boot_record_t record;
+
+static char const* const phase_names[BOOT_PHASE_COUNT] = {
+    "board", "tusb", "output", "settings", "loop", "mount", "first report", "stdio",
+};
+
+void boot_mark(boot_phase_t phase)
+{
+    uint16_t const bit = (uint16_t)(1u << phase);
+    if (record.reached & bit) return;
+    record.at_us[phase] = time_us_32();
+    record.reached |= bit;
+}
+
+bool boot_reached(boot_phase_t phase)
+{
+    return record.reached & (1u << phase);
+}
+
+boot_record_t boot_get_record(void)
+{
+    return record;
+}
+
+void boot_print(void)
+{
+    printf("Boot (fast start %s), us since reset:", ROLAND_FAST_START ? "on" : "off");
+    for (uint32_t p = 0; p < BOOT_PHASE_COUNT; p++) {
+        if (record.reached & (1u << p)) {
+            printf(" %s=%lu", phase_names[p], (unsigned long)record.at_us[p]);
+        } else {
+            printf(" %s=-", phase_names[p]);
+        }
+    }
+    printf("\n");
+}
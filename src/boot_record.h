@@ -0,0 +1,42 @@
+#ifndef _BOOT_RECORD_H_
+#define _BOOT_RECORD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Startzeiten bis zum ersten Report
+//
+// Der Roland versorgt den Pico über +5V; der Timer zählt ab dem Reset. Jede
+// Phase hält beim ersten Erreichen time_us_32() fest, spätere Aufrufe sind
+// ein Vergleich. Mit ROLAND_FAST_START=1 holt main() Board, stdio und
+// Startmeldung erst nach dem ersten Report nach; die Phasen zeigen, was das
+// bis zum nutzbaren Cursor spart.
+// -----------------------------------------------------------------------------
+
+typedef enum {
+    BOOT_BOARD = 0,      // board_init()
+    BOOT_TUSB,           // tusb_init()
+    BOOT_OUTPUT,         // output_task_start()
+    BOOT_SETTINGS,       // settings_init()
+    BOOT_LOOP,           // Hauptschleife erreicht
+    BOOT_MOUNT,          // erstes HID-Gerät gemountet
+    BOOT_FIRST_REPORT,   // erster HID-Report
+    BOOT_STDIO,          // stdio und Startmeldung
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+typedef struct {
+    uint32_t at_us[BOOT_PHASE_COUNT];   // µs seit Reset, gültig laut reached
+    uint16_t reached;                   // Bit je boot_phase_t
+} boot_record_t;
+
+static_assert(BOOT_PHASE_COUNT <= 16, "reached hat 16 Bit");
+
+void boot_mark(boot_phase_t phase);
+bool boot_reached(boot_phase_t phase);
+
+boot_record_t boot_get_record(void);
+void boot_print(void);
+
+#endif
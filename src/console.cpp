@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "ballistics.h"
+#include "boot_record.h"
+#include "console.h"
+#include "hid_pool.h"
+#include "hid_reports.h"
+#include "hid_setup.h"
+#include "latency.h"
+#include "mouse_merge.h"
+#include "msx_encode.h"
+#include "output_backend.h"
+#include "output_task.h"
+#include "scheduler.h"
+#include "settings.h"
+#include "trace.h"
+
+static void print_help(void)
+{
+    printf("Commands: s=stats, h=latency histogram, r=reset stats, d=dump trace, l=live trace on/off, p=boot policy, m=merge policy, b=ballistics profile, +/-=scale, x/y=invert axis, e=encode bench, o=output protocol, t=boot times, ?=help\n");
+}
+
+void console_service(void)
+{
+    int c = getchar_timeout_us(0);
+    if (c == PICO_ERROR_TIMEOUT) return;
+
+    switch (c) {
+    case 's':
+        scheduler_print_stats();
+        output_task_print_stats();
+        hid_reports_print_stats();
+        hid_setup_print_stats();
+        mouse_merge_print_stats();
+        ballistics_print();
+        settings_print();
+        hid_pool_print();
+        printf("Trace: live=%s, dropped=%lu\n",
+               trace_live() ? "on" : "off", (unsigned long)trace_dropped());
+        break;
+    case 'h':
+        latency_print();
+        break;
+    case 'r':
+        scheduler_reset_stats();
+        output_task_reset_stats();
+        hid_reports_reset_stats();
+        hid_setup_reset_stats();
+        mouse_merge_reset_stats();
+        latency_reset();
+        break;
+    case 'd':
+        trace_dump();
+        break;
+    case 'l':
+        trace_set_live(!trace_live());
+        printf("Live trace %s\n", trace_live() ? "on" : "off");
+        break;
+    case 'p':
+        hid_setup_set_policy((boot_policy_t)((hid_setup_policy() + 1) % (BOOT_POLICY_ALWAYS + 1)));
+        hid_setup_print_stats();
+        printf("(gilt ab dem naechsten Mount)\n");
+        break;
+    case 'm':
+        mouse_merge_set_policy((merge_policy_t)((mouse_merge_policy() + 1) % MERGE_POLICY_COUNT));
+        mouse_merge_print_stats();
+        break;
+    case 'b':
+        ballistics_set_profile((ballistics_profile_t)((ballistics_profile() + 1) % BALLISTICS_PROFILE_COUNT));
+        ballistics_print();
+        break;
+    case '+':
+    case '-':
+        ballistics_set_scale((uint16_t)(ballistics_scale() + (c == '+' ? 10 : -10)));
+        ballistics_print();
+        break;
+    case 'x':
+        ballistics_set_invert(ballistics_invert() ^ BALLISTICS_INVERT_X);
+        ballistics_print();
+        break;
+    case 'y':
+        ballistics_set_invert(ballistics_invert() ^ BALLISTICS_INVERT_Y);
+        ballistics_print();
+        break;
+    case 'o': {
+        uint8_t const next = (uint8_t)((output_task_backend() + 1) % OUTPUT_BACKEND_COUNT);
+        if (output_task_select(next)) {
+            printf("Output: %s\n", output_backend_table[next].name);
+        } else {
+            printf("Output: %s (fest, mit ROLAND_OUTPUT_RUNTIME=ON umschaltbar)\n", output_task_backend_name());
+        }
+        break;
+    }
+    case 't':
+        boot_print();
+        break;
+    case 'e':
+        msx_encode_bench();
+        break;
+    case '?':
+        print_help();
+        break;
+    default:
+        break;
+    }
+}
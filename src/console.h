@@ -0,0 +1,24 @@
+#ifndef _CONSOLE_H_
+#define _CONSOLE_H_
+
+// -----------------------------------------------------------------------------
+// UART-Konsole: Ein-Zeichen-Kommandos, nicht blockierend aus der
+// Hauptschleife abgefragt
+//
+//   s  Statistik ausgeben      r  Statistik zurücksetzen
+//   h  Latenz-Histogramm
+//   d  Trace-Ring ausgeben     l  Live-Trace ein/aus
+//   p  Boot-Policy weiterschalten (never/auto/always, ab nächstem Mount)
+//   m  Merge-Policy mehrerer Mäuse weiterschalten (sum/last-active/primary)
+//   b  Ballistik-Profil weiterschalten (linear/windows/s-curve)
+//   +  Skalierung +10 %        -  Skalierung -10 %
+//   x  X-Achse umkehren        y  Y-Achse umkehren
+//   e  Kodierung C/Interpolator messen
+//   o  Ausgangsprotokoll weiterschalten (nur ROLAND_OUTPUT_RUNTIME)
+//   t  Startzeiten je Phase
+//   ?  Hilfe
+// -----------------------------------------------------------------------------
+
+void console_service(void);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef _CYCLES_H_
+#define _CYCLES_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Zykluszähler für Kostenmessungen im Callback
+//
+// RP2040: SysTick läuft frei mit Systemtakt als 24-Bit-Abwärtszähler
+// (reicht bei 125 MHz für gut 130 ms). Host-Build: Nanosekunden.
+// -----------------------------------------------------------------------------
+
+#ifdef ROLAND_HOST_BUILD
+#include <chrono>
+
+static inline void cycles_init(void)
+{
+}
+
+static inline uint32_t cycles_now(void)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint32_t cycles_since(uint32_t start)
+{
+    return cycles_now() - start;
+}
+
+#define CYCLES_UNIT "ns"
+#else
+#include "hardware/structs/systick.h"
+
+static inline void cycles_init(void)
+{
+    systick_hw->csr = 0;
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+static inline uint32_t cycles_now(void)
+{
+    return systick_hw->cvr;
+}
+
+static inline uint32_t cycles_since(uint32_t start)
+{
+    return (start - systick_hw->cvr) & 0x00FFFFFF;
+}
+
+#define CYCLES_UNIT "cyc"
+#endif
+
+#endif
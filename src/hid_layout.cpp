@@ -0,0 +1,319 @@
+#include <string.h>
+
+#include "hid_layout.h"
+
+// -----------------------------------------------------------------------------
+// Minimaler Parser für HID-Report-Deskriptoren (HID 1.11, Kap. 6.2.2)
+//
+// Es werden nur Kurz-Items ausgewertet, die für Lage und Format der
+// Input-Felder nötig sind. Pro Report-ID wird die Bitposition mitgezählt;
+// gewählt wird am Ende die erste Report-ID, die X und Y enthält. Die
+// übrigen IDs werden nach ihrer Application Collection eingeordnet.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+enum { TYPE_MAIN = 0, TYPE_GLOBAL = 1, TYPE_LOCAL = 2 };
+
+enum {
+    MAIN_INPUT          = 0x8,
+    MAIN_COLLECTION     = 0xA,
+    GLOBAL_USAGE_PAGE   = 0x0,
+    GLOBAL_LOGICAL_MIN  = 0x1,
+    GLOBAL_REPORT_SIZE  = 0x7,
+    GLOBAL_REPORT_ID    = 0x8,
+    GLOBAL_REPORT_COUNT = 0x9,
+    GLOBAL_PUSH         = 0xA,
+    GLOBAL_POP          = 0xB,
+    LOCAL_USAGE         = 0x0,
+    LOCAL_USAGE_MIN     = 0x1,
+    LOCAL_USAGE_MAX     = 0x2,
+};
+
+constexpr uint16_t PAGE_DESKTOP = 0x01;
+constexpr uint16_t PAGE_BUTTON  = 0x09;
+constexpr uint16_t USAGE_X      = 0x30;
+constexpr uint16_t USAGE_Y      = 0x31;
+constexpr uint16_t USAGE_WHEEL  = 0x38;
+constexpr uint16_t USAGE_KEYBOARD = 0x06;
+constexpr uint16_t USAGE_KEYPAD   = 0x07;
+
+constexpr uint8_t COLLECTION_APPLICATION = 0x01;
+
+constexpr uint8_t MAX_USAGES     = 16;
+constexpr uint8_t MAX_REPORT_IDS = 16;   // weitere IDs werden verworfen
+constexpr uint8_t MAX_PUSH       = 2;
+constexpr uint8_t MAX_WIDTH      = 24;   // hid_field_get() liest höchstens 4 Bytes
+
+struct globals_t {
+    uint16_t usage_page;
+    int32_t  logical_min;
+    uint32_t report_size;
+    uint32_t report_count;
+    uint8_t  report_id;
+};
+
+struct found_t {
+    uint32_t offset;
+    uint8_t  width;
+    bool     is_signed;
+    bool     valid;
+};
+
+struct report_slot_t {
+    uint8_t  id;
+    uint32_t bits;                       // bisherige Länge in Bit (inkl. ID-Byte)
+    uint32_t application;                // Usage der Application Collection
+    found_t  field[HID_FIELD_COUNT];
+};
+
+struct parser_t {
+    globals_t     g;
+    globals_t     stack[MAX_PUSH];
+    uint8_t       sp;
+
+    uint32_t      usages[MAX_USAGES];
+    uint8_t       usage_count;
+    uint32_t      usage_min;
+    uint32_t      usage_max;
+    bool          has_range;
+
+    uint32_t      application;           // aktuelle Application Collection
+
+    report_slot_t slot[MAX_REPORT_IDS];
+    uint8_t       slot_count;
+};
+
+report_slot_t* slot_for(parser_t* p, uint8_t id)
+{
+    for (uint8_t i = 0; i < p->slot_count; i++) {
+        if (p->slot[i].id == id) return &p->slot[i];
+    }
+    if (p->slot_count == MAX_REPORT_IDS) return nullptr;
+
+    report_slot_t* s = &p->slot[p->slot_count++];
+    memset(s, 0, sizeof(*s));
+    s->id          = id;
+    s->bits        = id ? 8 : 0;
+    s->application = p->application;
+    return s;
+}
+
+uint32_t usage_at(parser_t const* p, uint32_t i)
+{
+    uint32_t usage;
+    if (p->usage_count) {
+        usage = p->usages[i < p->usage_count ? i : p->usage_count - 1];
+    } else if (p->has_range) {
+        usage = p->usage_min + i;
+        if (usage > p->usage_max) usage = p->usage_max;
+    } else {
+        return 0;
+    }
+    // Kurze Usage-Items gelten für die aktuelle Usage Page
+    if (!(usage >> 16)) usage |= (uint32_t)p->g.usage_page << 16;
+    return usage;
+}
+
+void record(found_t* f, uint32_t offset, uint8_t width, bool is_signed)
+{
+    if (f->valid) return;
+    f->offset    = offset;
+    f->width     = width;
+    f->is_signed = is_signed;
+    f->valid     = true;
+}
+
+void main_input(parser_t* p, uint32_t flags)
+{
+    report_slot_t* s = slot_for(p, p->g.report_id);
+    if (!s) return;
+
+    bool constant = flags & 0x01;
+    bool variable = flags & 0x02;
+    bool is_signed = p->g.logical_min < 0;
+
+    for (uint32_t i = 0; i < p->g.report_count; i++) {
+        uint32_t offset = s->bits;
+        s->bits += p->g.report_size;
+        if (constant || !variable) continue;
+
+        uint32_t usage = usage_at(p, i);
+        uint16_t page  = (uint16_t)(usage >> 16);
+        uint16_t id    = (uint16_t)usage;
+
+        if (page == PAGE_BUTTON && p->g.report_size == 1 && id >= 1 && id <= 8) {
+            // Tasten liegen als zusammenhängende 1-Bit-Felder ab Taste 1
+            found_t* b = &s->field[HID_FIELD_BUTTONS];
+            if (id == 1) record(b, offset, 1, false);
+            else if (b->valid && offset == b->offset + b->width) b->width++;
+        } else if (page == PAGE_DESKTOP && p->g.report_size <= MAX_WIDTH) {
+            uint8_t w = (uint8_t)p->g.report_size;
+            if      (id == USAGE_X)     record(&s->field[HID_FIELD_X], offset, w, is_signed);
+            else if (id == USAGE_Y)     record(&s->field[HID_FIELD_Y], offset, w, is_signed);
+            else if (id == USAGE_WHEEL) record(&s->field[HID_FIELD_WHEEL], offset, w, is_signed);
+        }
+    }
+}
+
+int32_t item_value(uint8_t const* data, uint8_t size, bool sign_extend)
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < size; i++) v |= (uint32_t)data[i] << (8 * i);
+    if (sign_extend && size && size < 4) {
+        uint8_t shift = (uint8_t)(32 - 8 * size);
+        return (int32_t)(v << shift) >> shift;
+    }
+    return (int32_t)v;
+}
+
+hid_route_t route_for(report_slot_t const* s, report_slot_t const* mouse)
+{
+    if (s == mouse) return HID_ROUTE_MOUSE;
+    uint16_t const page  = (uint16_t)(s->application >> 16);
+    uint16_t const usage = (uint16_t)s->application;
+    if (page == PAGE_DESKTOP && (usage == USAGE_KEYBOARD || usage == USAGE_KEYPAD)) return HID_ROUTE_KEYBOARD;
+    return HID_ROUTE_OTHER;
+}
+
+void set_route(hid_dispatch_t* d, uint8_t id, hid_route_t route)
+{
+    uint8_t const shift = (uint8_t)((id & 3) * 2);
+    d->route[id >> 2] = (uint8_t)((d->route[id >> 2] & ~(3u << shift)) | ((uint32_t)route << shift));
+}
+
+void compile_field(hid_field_t* out, found_t const* f)
+{
+    memset(out, 0, sizeof(*out));
+    out->rshift = 31;   // nicht vorhanden: liefert immer 0
+    if (!f->valid || !f->width) return;
+
+    uint8_t shift = f->offset & 7;
+    out->byte      = (uint16_t)(f->offset >> 3);
+    out->nbytes    = (uint8_t)((shift + f->width + 7) / 8);
+    out->lshift    = (uint8_t)(32 - shift - f->width);
+    out->rshift    = (uint8_t)(32 - f->width);
+    out->is_signed = f->is_signed;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Deskriptor -> Extraktionsplan
+// -----------------------------------------------------------------------------
+bool hid_layout_parse(hid_mouse_layout_t* layout, hid_dispatch_t* dispatch,
+                      uint8_t const* desc, uint16_t desc_len)
+{
+    static parser_t p;   // ~0.5 KB, nicht auf den Stack des USB-Callbacks
+    memset(&p, 0, sizeof(p));
+
+    uint16_t pos = 0;
+    while (pos < desc_len) {
+        uint8_t prefix = desc[pos++];
+
+        if (prefix == 0xFE) {   // Lang-Item: überspringen
+            if (pos + 1 >= desc_len) break;
+            pos = (uint16_t)(pos + 2 + desc[pos]);
+            continue;
+        }
+
+        uint8_t size = prefix & 0x03;
+        if (size == 3) size = 4;
+        uint8_t type = (prefix >> 2) & 0x03;
+        uint8_t tag  = prefix >> 4;
+        if (pos + size > desc_len) break;
+
+        uint8_t const* data = &desc[pos];
+        pos = (uint16_t)(pos + size);
+
+        if (type == TYPE_MAIN) {
+            if (tag == MAIN_INPUT) main_input(&p, (uint32_t)item_value(data, size, false));
+            if (tag == MAIN_COLLECTION && item_value(data, size, false) == COLLECTION_APPLICATION) {
+                p.application = usage_at(&p, 0);
+            }
+            // Lokale Items gelten nur bis zum nächsten Main-Item
+            p.usage_count = 0;
+            p.has_range   = false;
+        } else if (type == TYPE_GLOBAL) {
+            switch (tag) {
+            case GLOBAL_USAGE_PAGE:   p.g.usage_page   = (uint16_t)item_value(data, size, false); break;
+            case GLOBAL_LOGICAL_MIN:  p.g.logical_min  = item_value(data, size, true);            break;
+            case GLOBAL_REPORT_SIZE:  p.g.report_size  = (uint32_t)item_value(data, size, false); break;
+            case GLOBAL_REPORT_COUNT: p.g.report_count = (uint32_t)item_value(data, size, false); break;
+            case GLOBAL_REPORT_ID:    p.g.report_id    = (uint8_t)item_value(data, size, false);  break;
+            case GLOBAL_PUSH:
+                if (p.sp < MAX_PUSH) p.stack[p.sp++] = p.g;
+                break;
+            case GLOBAL_POP:
+                if (p.sp) p.g = p.stack[--p.sp];
+                break;
+            default: break;
+            }
+        } else if (type == TYPE_LOCAL) {
+            uint32_t v = (uint32_t)item_value(data, size, false);
+            switch (tag) {
+            case LOCAL_USAGE:
+                if (p.usage_count < MAX_USAGES) p.usages[p.usage_count++] = v;
+                break;
+            case LOCAL_USAGE_MIN: p.usage_min = v; p.has_range = true; break;
+            case LOCAL_USAGE_MAX: p.usage_max = v; p.has_range = true; break;
+            default: break;
+            }
+        }
+    }
+
+    report_slot_t const* mouse = nullptr;
+    for (uint8_t i = 0; i < p.slot_count && !mouse; i++) {
+        report_slot_t const* s = &p.slot[i];
+        if (!s->field[HID_FIELD_X].valid || !s->field[HID_FIELD_Y].valid) continue;
+
+        mouse = s;
+        layout->report_id = s->id;
+        layout->min_len   = (uint16_t)((s->bits + 7) / 8);
+        for (uint8_t f = 0; f < HID_FIELD_COUNT; f++) {
+            compile_field(&layout->field[f], &s->field[f]);
+        }
+    }
+
+    if (dispatch) {
+        memset(dispatch, 0, sizeof(*dispatch));
+        for (uint8_t i = 0; i < p.slot_count; i++) {
+            if (p.slot[i].id) dispatch->uses_ids = true;
+            set_route(dispatch, p.slot[i].id, route_for(&p.slot[i], mouse));
+        }
+    }
+    return mouse != nullptr;
+}
+
+void hid_layout_boot(hid_mouse_layout_t* layout)
+{
+    // Boot-Maus: Byte 0 Tasten, Byte 1 X, Byte 2 Y (HID 1.11, Anhang B.2).
+    // Das Rad ist optional und wird daher nicht gelesen.
+    found_t const buttons = {  0, 8, false, true };
+    found_t const x       = {  8, 8, true,  true };
+    found_t const y       = { 16, 8, true,  true };
+    found_t const none    = {  0, 0, false, false };
+
+    layout->report_id = 0;
+    layout->min_len   = 3;
+    compile_field(&layout->field[HID_FIELD_BUTTONS], &buttons);
+    compile_field(&layout->field[HID_FIELD_X], &x);
+    compile_field(&layout->field[HID_FIELD_Y], &y);
+    compile_field(&layout->field[HID_FIELD_WHEEL], &none);
+}
+
+static bool field_equal(hid_field_t const* a, hid_field_t const* b)
+{
+    return a->byte == b->byte && a->nbytes == b->nbytes && a->lshift == b->lshift &&
+           a->rshift == b->rshift && a->is_signed == b->is_signed;
+}
+
+bool hid_layout_boot_compatible(hid_mouse_layout_t const* layout)
+{
+    hid_mouse_layout_t boot;
+    hid_layout_boot(&boot);
+
+    return layout->report_id == 0 &&
+           field_equal(&layout->field[HID_FIELD_X], &boot.field[HID_FIELD_X]) &&
+           field_equal(&layout->field[HID_FIELD_Y], &boot.field[HID_FIELD_Y]);
+}
@@ -0,0 +1,124 @@
+#ifndef _HID_LAYOUT_H_
+#define _HID_LAYOUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Aus dem Report-Deskriptor kompilierter Extraktionsplan für Mäuse
+//
+// Beim Mount wird der Deskriptor einmal geparst; pro Feld bleiben nur
+// Byte-Position, Anzahl zu lesender Bytes und zwei Shifts übrig. Die
+// Dekodierung je Report ist damit ein fester Durchlauf ohne Deskriptorlogik.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint16_t byte;      // erstes Byte im Report
+    uint8_t  nbytes;    // 0 = Feld nicht vorhanden
+    uint8_t  lshift;    // Feld linksbündig schieben ...
+    uint8_t  rshift;    // ... und auf Breite zurückschieben
+    bool     is_signed;
+} hid_field_t;
+
+enum {
+    HID_FIELD_BUTTONS = 0,
+    HID_FIELD_X,
+    HID_FIELD_Y,
+    HID_FIELD_WHEEL,
+    HID_FIELD_COUNT
+};
+
+typedef struct {
+    uint8_t     report_id;  // 0 = Gerät benutzt keine Report-IDs
+    uint16_t    min_len;    // Mindestlänge des Reports in Bytes (inkl. ID)
+    hid_field_t field[HID_FIELD_COUNT];
+} hid_mouse_layout_t;
+
+// -----------------------------------------------------------------------------
+// Verteilung nach Report-ID
+//
+// Empfänger kabelloser Sets melden Tastatur, Maus und Consumer Control oft
+// über ein Interface mit Report-IDs. Beim Mount entsteht daraus eine Tabelle
+// mit 2 Bit je ID; vor dem Kopieren eines Reports entscheidet ein Zugriff,
+// ob er zur Maus gehört. Alles andere wird ohne Dekodierung verworfen.
+// -----------------------------------------------------------------------------
+
+typedef enum {
+    HID_ROUTE_NONE = 0,   // ID im Deskriptor nicht als Input beschrieben
+    HID_ROUTE_MOUSE,      // die ID des Extraktionsplans
+    HID_ROUTE_KEYBOARD,
+    HID_ROUTE_OTHER,      // Consumer Control, System Control, Hersteller, ...
+    HID_ROUTE_COUNT
+} hid_route_t;
+
+typedef struct {
+    bool    uses_ids;     // erstes Report-Byte ist die Report-ID
+    uint8_t route[64];    // 256 IDs zu je 2 Bit (ohne IDs gilt Eintrag 0)
+} hid_dispatch_t;
+
+static inline hid_route_t hid_dispatch_route(hid_dispatch_t const* d, uint8_t const* report, uint16_t len)
+{
+    if (!len) return HID_ROUTE_NONE;
+    uint8_t const id = d->uses_ids ? report[0] : 0;
+    return (hid_route_t)((d->route[id >> 2] >> ((id & 3) * 2)) & 3);
+}
+
+typedef struct {
+    uint8_t buttons;
+    int32_t x;
+    int32_t y;
+    int32_t wheel;
+} hid_mouse_sample_t;
+
+// Deskriptor parsen; false, wenn keine X/Y-Achsen gefunden wurden.
+// dispatch (optional) erhält die Zuordnung aller Input-Report-IDs.
+bool hid_layout_parse(hid_mouse_layout_t* layout, hid_dispatch_t* dispatch,
+                      uint8_t const* desc, uint16_t desc_len);
+
+// Festes Layout des Boot-Protokolls (buttons, x, y, wheel je 8 Bit)
+void hid_layout_boot(hid_mouse_layout_t* layout);
+
+// true, wenn Reports im Report-Protokoll schon Boot-Format haben (keine
+// Report-ID, X/Y als 8 Bit in Byte 1/2): Boot-Protokoll verliert dann nichts
+bool hid_layout_boot_compatible(hid_mouse_layout_t const* layout);
+
+// Ein Feld lesen (Feld nicht vorhanden: 0)
+static inline int32_t hid_field_get(hid_field_t const* f, uint8_t const* report)
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < f->nbytes; i++) {
+        v |= (uint32_t)report[f->byte + i] << (8 * i);
+    }
+    v <<= f->lshift;
+    return f->is_signed ? ((int32_t)v >> f->rshift) : (int32_t)(v >> f->rshift);
+}
+
+// Report dekodieren; false bei falscher Report-ID oder zu kurzem Report
+static inline bool hid_layout_decode(hid_mouse_layout_t const* layout,
+                                     uint8_t const* report, uint16_t len,
+                                     hid_mouse_sample_t* out)
+{
+    if (len < layout->min_len) return false;
+    if (layout->report_id && report[0] != layout->report_id) return false;
+
+    out->buttons = (uint8_t)hid_field_get(&layout->field[HID_FIELD_BUTTONS], report);
+    out->x       = hid_field_get(&layout->field[HID_FIELD_X], report);
+    out->y       = hid_field_get(&layout->field[HID_FIELD_Y], report);
+    out->wheel   = hid_field_get(&layout->field[HID_FIELD_WHEEL], report);
+    return true;
+}
+
+// Boot-Protokoll: feste 3 oder 4 Bytes, kein Plan nötig
+static inline bool hid_boot_decode(uint8_t const* report, uint16_t len,
+                                   hid_mouse_sample_t* out)
+{
+    if (len < 3) return false;
+
+    out->buttons = report[0];
+    out->x       = (int8_t)report[1];
+    out->y       = (int8_t)report[2];
+    out->wheel   = len > 3 ? (int8_t)report[3] : 0;
+    return true;
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include <stdio.h>
+
+#include "hid_pool.h"
+
+static hid_device_t pool[HID_POOL_SIZE];
+
+// Index + 1 je (dev_addr, instance); 0 = nicht belegt
+static uint8_t slot_of[HID_DEV_SLOTS][CFG_TUH_HID];
+
+// Freigegebene Einträge; noch nie benutzte kommen der Reihe nach dazu,
+// dadurch braucht der Pool keine Initialisierung
+static uint8_t  free_stack[HID_POOL_SIZE];
+static uint32_t free_count;
+static uint32_t never_used;
+
+static hid_pool_stats_t stats;
+
+static_assert(HID_POOL_SIZE < 255, "slot_of speichert Index + 1 in uint8_t");
+
+static inline bool valid_addr(uint8_t dev_addr, uint8_t instance)
+{
+    return dev_addr && dev_addr <= HID_DEV_SLOTS && instance < CFG_TUH_HID;
+}
+
+hid_device_t* hid_pool_claim(uint8_t dev_addr, uint8_t instance)
+{
+    if (!valid_addr(dev_addr, instance)) {
+        stats.claim_failed++;
+        return NULL;
+    }
+
+    // Unmount verpasst: alten Eintrag zuerst freigeben
+    hid_pool_release(dev_addr, instance);
+
+    uint32_t idx;
+    if (free_count)                      idx = free_stack[--free_count];
+    else if (never_used < HID_POOL_SIZE) idx = never_used++;
+    else {
+        stats.claim_failed++;
+        return NULL;
+    }
+
+    hid_device_t*  dev        = &pool[idx];
+    uint16_t const generation = dev->generation;
+    *dev = hid_device_t{};
+    dev->generation = generation;
+    dev->dev_addr   = dev_addr;
+    dev->instance   = instance;
+    ballistics_set_interval(&dev->ballistics, 0);   // bis bInterval bekannt ist
+    tuh_vid_pid_get(dev_addr, &dev->vid, &dev->pid);
+
+    slot_of[dev_addr - 1][instance] = (uint8_t)(idx + 1);
+    if (++stats.in_use > stats.high_water) stats.high_water = stats.in_use;
+    return dev;
+}
+
+void hid_pool_release(uint8_t dev_addr, uint8_t instance)
+{
+    hid_device_t* dev = hid_pool_find(dev_addr, instance);
+    if (!dev) return;
+
+    slot_of[dev_addr - 1][instance] = 0;
+    dev->dev_addr = 0;
+    dev->generation++;
+    free_stack[free_count++] = (uint8_t)hid_pool_index(dev);
+    stats.in_use--;
+}
+
+hid_device_t* hid_pool_find(uint8_t dev_addr, uint8_t instance)
+{
+    if (!valid_addr(dev_addr, instance)) return NULL;
+    uint8_t s = slot_of[dev_addr - 1][instance];
+    return s ? &pool[s - 1] : NULL;
+}
+
+hid_device_t* hid_pool_at(uint32_t index)
+{
+    return index < HID_POOL_SIZE ? &pool[index] : NULL;
+}
+
+uint32_t hid_pool_index(hid_device_t const* dev)
+{
+    return (uint32_t)(dev - pool);
+}
+
+hid_handle_t hid_pool_handle(hid_device_t const* dev)
+{
+    return ((hid_handle_t)dev->generation << 8) | hid_pool_index(dev);
+}
+
+hid_device_t* hid_pool_from_handle(hid_handle_t handle)
+{
+    uint32_t idx = handle & 0xFF;
+    if (idx >= HID_POOL_SIZE) return NULL;
+
+    hid_device_t* dev = &pool[idx];
+    if (!dev->dev_addr || dev->generation != (uint16_t)(handle >> 8)) return NULL;
+    return dev;
+}
+
+hid_pool_stats_t hid_pool_get_stats(void)
+{
+    return stats;
+}
+
+void hid_pool_print(void)
+{
+    printf("Devices: %lu/%u in use, high water %lu, claim failed %lu\n",
+           (unsigned long)stats.in_use, (unsigned)HID_POOL_SIZE,
+           (unsigned long)stats.high_water, (unsigned long)stats.claim_failed);
+
+    for (uint32_t i = 0; i < HID_POOL_SIZE; i++) {
+        hid_device_t const* dev = &pool[i];
+        if (!dev->dev_addr) continue;
+        rate_meter_t const* r = &dev->rate;
+        printf("  [%lu] addr=%u inst=%u gen=%u %04x:%04x %s%s reports=%lu errors=%lu sum=(%ld,%ld)\n",
+               (unsigned long)i, dev->dev_addr, dev->instance, dev->generation, dev->vid, dev->pid,
+               dev->setup.mode == HID_MODE_BOOT ? "boot" : "report",
+               dev->layout_ok ? "" : " (no layout)",
+               (unsigned long)dev->reports, (unsigned long)dev->errors,
+               (long)dev->sum_x, (long)dev->sum_y);
+        printf("       filtered: unknown id=%lu, keyboard=%lu, other=%lu\n",
+               (unsigned long)dev->filtered[HID_ROUTE_NONE], (unsigned long)dev->filtered[HID_ROUTE_KEYBOARD],
+               (unsigned long)dev->filtered[HID_ROUTE_OTHER]);
+        printf("       bInterval=%lu us, rate=%lu Hz, jitter=%lu us, max=%lu us, gaps=%lu, missed frames=%lu\n",
+               (unsigned long)r->expected_us, (unsigned long)rate_meter_hz(r),
+               (unsigned long)rate_meter_jitter_us(r), (unsigned long)r->max_us,
+               (unsigned long)r->gaps, (unsigned long)r->missed);
+    }
+}
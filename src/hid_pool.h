@@ -0,0 +1,82 @@
+#ifndef _HID_POOL_H_
+#define _HID_POOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tusb.h"
+#include "ballistics.h"
+#include "hid_layout.h"
+#include "hid_setup.h"
+#include "mouse_merge.h"
+#include "rate_meter.h"
+
+// -----------------------------------------------------------------------------
+// Statischer Pool für den Zustand je HID-Instanz (ohne Heap)
+//
+// Die Größe steht zur Compile-Zeit fest: CFG_TUH_DEVICE_MAX Geräte mit je
+// CFG_TUH_HID Instanzen. Eine Indextabelle über (dev_addr, instance) macht
+// Suchen, Belegen (Mount) und Freigeben (Unmount) zu O(1); freie Einträge
+// liegen auf einem Stapel.
+//
+// Jede Freigabe erhöht die Generation des Eintrags. Ein Handle enthält
+// Index und Generation, damit verspätete Ereignisse (z. B. der Abschluss
+// eines Control-Transfers) nach einem Umstecken ins Leere laufen, auch wenn
+// das neue Gerät dieselbe Adresse bekommt.
+// -----------------------------------------------------------------------------
+
+// Geräteadressen 1..N (Hubs belegen eigene Adressen)
+#define HID_DEV_SLOTS  (CFG_TUH_DEVICE_MAX + CFG_TUH_HUB)
+
+#define HID_POOL_SIZE  (CFG_TUH_DEVICE_MAX * CFG_TUH_HID)
+
+typedef uint32_t hid_handle_t;   // Generation << 8 | Index
+
+struct hid_device_s {
+    uint8_t  dev_addr;           // 0 = frei
+    uint8_t  instance;
+    uint16_t generation;
+    uint16_t vid;
+    uint16_t pid;
+
+    hid_mouse_layout_t layout;   // Plan für das Report-Protokoll
+    bool               layout_ok;
+    hid_dispatch_t     dispatch;   // Report-ID -> Maus oder verwerfen
+
+    hid_setup_state_t  setup;    // Protokoll, Setup-Schritte, Quirk-Policy
+    merge_source_t     merge;    // Zustand als Quelle des Bewegungsstroms
+    rate_meter_t       rate;     // Report-Abstände gegen bInterval
+    ballistics_t       ballistics; // Rest unter einem Count je Achse
+
+    uint32_t reports;            // dekodierte Mausreports
+    uint32_t errors;             // verworfen: zu kurz oder nicht dekodierbar
+    uint32_t filtered[HID_ROUTE_COUNT];   // vor dem Kopieren verworfen, je Ziel
+    int32_t  sum_x;              // Bewegung seit dem Mount
+    int32_t  sum_y;
+};
+
+typedef struct {
+    uint32_t in_use;
+    uint32_t high_water;
+    uint32_t claim_failed;       // Pool voll oder Adresse außerhalb
+} hid_pool_stats_t;
+
+// Mount: Eintrag belegen (vorhandener Eintrag derselben Instanz wird ersetzt)
+hid_device_t* hid_pool_claim(uint8_t dev_addr, uint8_t instance);
+
+// Unmount: Eintrag freigeben (nichts belegt: ohne Wirkung)
+void hid_pool_release(uint8_t dev_addr, uint8_t instance);
+
+hid_device_t* hid_pool_find(uint8_t dev_addr, uint8_t instance);
+
+// Index 0..HID_POOL_SIZE-1; freie Einträge haben dev_addr 0
+hid_device_t* hid_pool_at(uint32_t index);
+uint32_t      hid_pool_index(hid_device_t const* dev);
+
+hid_handle_t  hid_pool_handle(hid_device_t const* dev);
+hid_device_t* hid_pool_from_handle(hid_handle_t handle);
+
+hid_pool_stats_t hid_pool_get_stats(void);
+void hid_pool_print(void);
+
+#endif
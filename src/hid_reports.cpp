@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+#include "cycles.h"
+#include "hid_pool.h"
+#include "hid_reports.h"
+#include "hid_setup.h"
+#include "mouse_merge.h"
+#include "trace.h"
+
+#ifndef ROLAND_REPORT_INLINE
+#define ROLAND_REPORT_INLINE 0
+#endif
+
+// Slots im Ring; die Hauptschleife leert ihn nach jedem tuh_task()
+#ifndef ROLAND_REPORT_RING
+#define ROLAND_REPORT_RING 16
+#endif
+
+#ifndef CFG_TUH_HID_EPIN_BUFSIZE
+#define CFG_TUH_HID_EPIN_BUFSIZE 64
+#endif
+
+typedef struct {
+    hid_handle_t handle;      // Generation prüft, ob das Gerät noch dasselbe ist
+    uint32_t     arrival_us;
+    uint16_t     len;
+    uint8_t      data[CFG_TUH_HID_EPIN_BUFSIZE];
+} report_slot_t;
+
+// Callback und Hauptschleife laufen beide im Thread-Kontext von Core0
+// (tuh_task ruft den Callback), daher genügen einfache Indizes
+static report_slot_t ring[ROLAND_REPORT_RING];
+static uint32_t      head;
+static uint32_t      tail;
+
+static hid_reports_stats_t stats;
+
+// Dekodieren und weitergeben; Boot-Protokoll: fester Pfad, sonst über den
+// beim Mount erstellten Plan
+static void process(hid_device_t* dev, uint8_t const* report, uint16_t len, uint32_t arrival_us)
+{
+    uint32_t const start = cycles_now();
+
+    hid_mode_t const mode = hid_setup_mode(dev);
+    hid_mouse_sample_t mouse;
+    bool ok;
+
+    if (mode == HID_MODE_BOOT) {
+        ok = hid_boot_decode(report, len, &mouse);
+    } else {
+        ok = dev->layout_ok && hid_layout_decode(&dev->layout, report, len, &mouse);
+    }
+
+    if (!ok) {
+        dev->errors++;
+        return;
+    }
+
+    dev->reports++;
+    rate_meter_note(&dev->rate, arrival_us, mouse.x || mouse.y);
+    dev->sum_x += mouse.x;
+    dev->sum_y += mouse.y;
+
+    int32_t dx = mouse.x;
+    int32_t dy = mouse.y;
+    ballistics_apply(&dev->ballistics, &dx, &dy);
+    mouse_merge_report(dev, dx, dy, mouse.buttons, arrival_us);
+    trace_report(dev->dev_addr, dev->instance, &mouse, arrival_us);   // Ausgabe erst in der Hauptschleife
+
+    hid_setup_note_report(mode, cycles_since(start));
+}
+
+// Mausreport übernehmen: in den Ring kopieren (oder gleich verarbeiten)
+static void accept(hid_device_t* dev, uint8_t const* report, uint16_t len, uint32_t arrival_us)
+{
+#if ROLAND_REPORT_INLINE
+    process(dev, report, len, arrival_us);
+#else
+    // Erst kopieren, dann neu anfordern: der nächste Transfer schreibt in
+    // denselben Puffer
+    if (head - tail >= ROLAND_REPORT_RING) {
+        stats.dropped++;
+        return;
+    }
+    report_slot_t* slot = &ring[head % ROLAND_REPORT_RING];
+    if (len > sizeof(slot->data)) {
+        len = sizeof(slot->data);
+        stats.truncated++;
+    }
+    slot->handle     = hid_pool_handle(dev);
+    slot->arrival_us = arrival_us;
+    slot->len        = len;
+    memcpy(slot->data, report, len);
+    head++;
+    if (head - tail > stats.ring_high_water) stats.ring_high_water = head - tail;
+#endif
+}
+
+void hid_reports_receive(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len)
+{
+    uint32_t const arrival_us = time_us_32();
+    uint32_t const start      = cycles_now();
+
+    stats.received++;
+    hid_device_t* dev = hid_pool_find(dev_addr, instance);
+    if (!dev) return;   // nicht verwaltet (Pool war beim Mount voll)
+
+    // Im Report-Protokoll nur die Maus-ID weitergeben; Tastatur und
+    // Consumer Control kosten damit weder Ring-Slot noch Dekodierung
+    hid_route_t const route = hid_setup_mode(dev) == HID_MODE_BOOT
+                            ? HID_ROUTE_MOUSE : hid_dispatch_route(&dev->dispatch, report, len);
+    if (route == HID_ROUTE_MOUSE) {
+        accept(dev, report, len, arrival_us);
+    } else {
+        dev->filtered[route]++;
+        stats.filtered++;
+    }
+
+    // Nächsten Report anfordern
+    tuh_hid_receive_report(dev_addr, instance);
+
+    uint32_t const unarmed = cycles_since(start);
+    stats.unarmed_sum += unarmed;
+    if (unarmed > stats.unarmed_max) stats.unarmed_max = unarmed;
+}
+
+void hid_reports_service(void)
+{
+    uint32_t const batch = head - tail;
+    if (!batch) return;
+
+    if (batch > stats.batch_max) stats.batch_max = batch;
+    stats.coalesced += batch - 1;
+
+    while (tail != head) {
+        report_slot_t const* slot = &ring[tail % ROLAND_REPORT_RING];
+        hid_device_t* dev = hid_pool_from_handle(slot->handle);
+        if (dev) {
+            process(dev, slot->data, slot->len, slot->arrival_us);
+            stats.processed++;
+        } else {
+            stats.stale++;
+        }
+        tail++;
+    }
+}
+
+hid_reports_stats_t hid_reports_get_stats(void)
+{
+    hid_reports_stats_t s = stats;
+    s.ring_capacity = ROLAND_REPORT_RING;
+    return s;
+}
+
+void hid_reports_reset_stats(void)
+{
+    stats = hid_reports_stats_t{};
+}
+
+void hid_reports_print_stats(void)
+{
+    hid_reports_stats_t s = hid_reports_get_stats();
+    printf("Reports[%s]: received=%lu, filtered=%lu, processed=%lu, dropped=%lu, stale=%lu, truncated=%lu, "
+           "coalesced=%lu, batch max=%lu, ring hwm=%lu/%lu, unarmed avg/max=%lu/%lu " CYCLES_UNIT "\n",
+           ROLAND_REPORT_INLINE ? "inline" : "deferred",
+           (unsigned long)s.received, (unsigned long)s.filtered, (unsigned long)s.processed, (unsigned long)s.dropped,
+           (unsigned long)s.stale, (unsigned long)s.truncated, (unsigned long)s.coalesced,
+           (unsigned long)s.batch_max, (unsigned long)s.ring_high_water, (unsigned long)s.ring_capacity,
+           (unsigned long)(s.received ? s.unarmed_sum / s.received : 0), (unsigned long)s.unarmed_max);
+}
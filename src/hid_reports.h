@@ -0,0 +1,45 @@
+#ifndef _HID_REPORTS_H_
+#define _HID_REPORTS_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Report-Empfang
+//
+// Der Callback prüft über die Report-ID, ob der Report zur Maus gehört
+// (hid_dispatch_t), kopiert ihn in einen Ring-Slot und fordert sofort den
+// nächsten an; der Endpunkt ist damit nur für die Dauer der Kopie unbewaffnet.
+// Dekodieren, Zusammenführen und Trace laufen danach in der Hauptschleife
+// (hid_reports_service). Die Kopie ist nötig, weil TinyUSB für den nächsten
+// Transfer denselben Puffer benutzt.
+//
+// Mit ROLAND_REPORT_INLINE=1 wird zum Vergleich wie früher im Callback
+// dekodiert und erst danach neu angefordert.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t received;      // Callbacks
+    uint32_t filtered;      // keine Maus-Report-ID, ohne Kopie verworfen
+    uint32_t processed;     // aus dem Ring verarbeitet
+    uint32_t dropped;       // Ring voll
+    uint32_t stale;         // Gerät vor der Verarbeitung getrennt
+    uint32_t truncated;     // länger als ein Slot
+    uint32_t coalesced;     // mit anderen Reports im selben Durchlauf verarbeitet
+    uint32_t batch_max;     // meiste Reports in einem Durchlauf
+    uint32_t ring_high_water;
+    uint32_t ring_capacity;
+    uint64_t unarmed_sum;   // Callback-Eintritt bis neu angefordert (CYCLES_UNIT)
+    uint32_t unarmed_max;
+} hid_reports_stats_t;
+
+// Aus tuh_hid_report_received_cb
+void hid_reports_receive(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
+
+// Hauptschleife: anstehende Reports verarbeiten
+void hid_reports_service(void);
+
+hid_reports_stats_t hid_reports_get_stats(void);
+void hid_reports_reset_stats(void);
+void hid_reports_print_stats(void);
+
+#endif
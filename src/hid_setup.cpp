@@ -0,0 +1,326 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "cycles.h"
+#include "hid_pool.h"
+#include "hid_setup.h"
+
+#ifndef ROLAND_BOOT_POLICY
+#define ROLAND_BOOT_POLICY 1
+#endif
+
+// Versuche je Schritt, solange der Control-Endpunkt belegt ist: ein Versuch
+// je Hauptschleifendurchlauf. Die Schleife läuft spätestens nach dem
+// Idle-Timeout (10 ms), bei USB-Verkehr öfter; das sind also höchstens ~1 s.
+#ifndef ROLAND_SETUP_RETRIES
+#define ROLAND_SETUP_RETRIES 100
+#endif
+
+typedef enum {
+    STEP_NONE = 0,       // nicht gemountet
+    STEP_GET_CONFIG,     // bInterval aus dem Konfigurationsdeskriptor
+    STEP_WAIT_CONFIG,
+    STEP_SET_PROTOCOL,
+    STEP_WAIT_PROTOCOL,
+    STEP_SET_IDLE,
+    STEP_WAIT_IDLE,
+    STEP_RUNNING,        // Reports werden angefordert
+} step_t;
+
+// Geräte mit eigener Policy, z. B. { 0x046d, 0xc077, BOOT_POLICY_NEVER }
+typedef struct {
+    uint16_t      vid;
+    uint16_t      pid;
+    boot_policy_t policy;
+} quirk_t;
+
+static quirk_t const quirks[] = {
+    { 0, 0, BOOT_POLICY_AUTO },   // Endmarke
+};
+
+// Konfigurationsdeskriptor; es läuft immer nur ein Control-Transfer
+#define CONFIG_BUF_SIZE 256
+static uint8_t           config_buf[CONFIG_BUF_SIZE];
+static bool              config_busy;
+static hid_handle_t      config_owner;   // Instanz des laufenden Transfers
+
+static uint32_t          pending;   // Instanzen mit offenem Setup-Schritt
+static boot_policy_t     policy = (boot_policy_t)ROLAND_BOOT_POLICY;
+static hid_setup_stats_t stats;
+
+static char const* const policy_names[] = { "never", "auto", "always" };
+static char const* const mode_names[]   = { "report", "boot" };
+
+static boot_policy_t device_policy(hid_device_t const* dev)
+{
+    for (quirk_t const* q = quirks; q->vid; q++) {
+        if (q->vid == dev->vid && q->pid == dev->pid) return q->policy;
+    }
+    return policy;
+}
+
+static void start_reports(hid_device_t* dev)
+{
+    hid_setup_state_t* s = &dev->setup;
+    s->step = STEP_RUNNING;
+    pending--;
+    stats.mode[s->mode].instances++;
+    printf("HID protocol: addr=%u, instance=%u, %s\n", dev->dev_addr, dev->instance, mode_names[s->mode]);
+
+    // ersten Report anfordern
+    tuh_hid_receive_report(dev->dev_addr, dev->instance);
+}
+
+// true: Schritt aufgeben
+static bool retry(hid_setup_state_t* s)
+{
+    stats.setup_retries++;
+    return ++s->retries >= ROLAND_SETUP_RETRIES;
+}
+
+static void next_step(hid_setup_state_t* s, step_t step)
+{
+    s->step    = step;
+    s->retries = 0;
+}
+
+// -----------------------------------------------------------------------------
+// SET_IDLE(0): Dauer unendlich für alle Report-IDs, d. h. Reports nur bei
+// Änderung. Ein STALL ist erlaubt (Idle ist für Mäuse optional).
+// user_data ist das Pool-Handle: nach einem Umstecken passt die Generation
+// nicht mehr und der Abschluss wird ignoriert.
+// -----------------------------------------------------------------------------
+static void set_idle_complete(tuh_xfer_t* xfer)
+{
+    hid_device_t* dev = hid_pool_from_handle((hid_handle_t)xfer->user_data);
+    if (dev && dev->setup.step == STEP_WAIT_IDLE) start_reports(dev);
+}
+
+static bool send_set_idle(hid_device_t const* dev)
+{
+    tuh_itf_info_t info;
+    if (!tuh_hid_itf_get_info(dev->dev_addr, dev->instance, &info)) return false;
+
+    tusb_control_request_t req = {};
+    req.bmRequestType_bit.recipient = TUSB_REQ_RCPT_INTERFACE;
+    req.bmRequestType_bit.type      = TUSB_REQ_TYPE_CLASS;
+    req.bmRequestType_bit.direction = TUSB_DIR_OUT;
+    req.bRequest = HID_REQ_CONTROL_SET_IDLE;
+    req.wValue   = 0;
+    req.wIndex   = info.desc.bInterfaceNumber;
+    req.wLength  = 0;
+
+    tuh_xfer_t xfer = {};
+    xfer.daddr       = dev->dev_addr;
+    xfer.ep_addr     = 0;
+    xfer.setup       = &req;
+    xfer.buffer      = NULL;
+    xfer.complete_cb = set_idle_complete;
+    xfer.user_data   = hid_pool_handle(dev);
+    return tuh_control_xfer(&xfer);
+}
+
+// -----------------------------------------------------------------------------
+// Konfigurationsdeskriptor: bInterval des Interrupt-IN-Endpunkts der Instanz
+// für die Rate-Messung. Ohne Ergebnis bleibt die Lückenerkennung aus.
+// -----------------------------------------------------------------------------
+static uint8_t find_interval(uint8_t const* desc, uint16_t len, uint8_t itf_num)
+{
+    bool in_itf = false;
+    for (uint16_t i = 0; i + 2 <= len && desc[i] >= 2 && i + desc[i] <= len; i += desc[i]) {
+        uint8_t const* d = &desc[i];
+        if (d[1] == TUSB_DESC_INTERFACE && d[0] >= 4) {
+            in_itf = d[2] == itf_num && d[3] == 0;
+        } else if (d[1] == TUSB_DESC_ENDPOINT && d[0] >= 7 && in_itf &&
+                   (d[2] & 0x80) && (d[3] & 0x03) == TUSB_XFER_INTERRUPT) {
+            return d[6];
+        }
+    }
+    return 0;
+}
+
+static void protocol_or_idle(hid_setup_state_t* s)
+{
+    next_step(s, s->want != s->mode ? STEP_SET_PROTOCOL : STEP_SET_IDLE);
+}
+
+static void get_config_complete(tuh_xfer_t* xfer)
+{
+    // Auch Fehler und Abbruch geben den Puffer frei; ein verspäteter Abschluss
+    // einer abgebauten Instanz lässt den Transfer einer neuen stehen
+    if ((hid_handle_t)xfer->user_data == config_owner) config_busy = false;
+
+    hid_device_t* dev = hid_pool_from_handle((hid_handle_t)xfer->user_data);
+    if (!dev || dev->setup.step != STEP_WAIT_CONFIG) return;
+
+    tuh_itf_info_t info;
+    uint8_t interval = 0;
+    if (xfer->result == XFER_RESULT_SUCCESS &&
+        tuh_hid_itf_get_info(dev->dev_addr, dev->instance, &info)) {
+        interval = find_interval(config_buf, (uint16_t)xfer->actual_len, info.desc.bInterfaceNumber);
+    }
+    // Full/Low Speed: bInterval in ms
+    rate_meter_start(&dev->rate, interval * 1000u);
+    ballistics_set_interval(&dev->ballistics, interval * 1000u);
+    protocol_or_idle(&dev->setup);
+}
+
+static bool send_get_config(hid_device_t const* dev)
+{
+    if (config_busy) return false;
+    config_busy  = true;   // vor dem Aufruf: der Abschluss kann sofort kommen
+    config_owner = hid_pool_handle(dev);
+    if (!tuh_descriptor_get_configuration(dev->dev_addr, 0, config_buf, CONFIG_BUF_SIZE,
+                                          get_config_complete, hid_pool_handle(dev))) {
+        config_busy = false;
+        return false;
+    }
+    return true;
+}
+
+void tuh_hid_set_protocol_complete_cb(uint8_t dev_addr, uint8_t idx, uint8_t protocol)
+{
+    hid_device_t* dev = hid_pool_find(dev_addr, idx);
+    if (!dev || dev->setup.step != STEP_WAIT_PROTOCOL) return;
+
+    hid_setup_state_t* s = &dev->setup;
+    // protocol ist das tatsächlich aktive Protokoll, auch wenn das Gerät
+    // den Wechsel abgelehnt hat
+    s->mode = protocol == HID_PROTOCOL_BOOT ? HID_MODE_BOOT : HID_MODE_REPORT;
+    if (s->mode != s->want) stats.setup_failed++;
+    next_step(s, STEP_SET_IDLE);
+}
+
+// -----------------------------------------------------------------------------
+
+void hid_setup_init(void)
+{
+    // Umschalten entscheidet die Policy nach dem Deskriptor, nicht TinyUSB
+    tuh_hid_set_default_protocol(HID_PROTOCOL_REPORT);
+}
+
+void hid_setup_mount(hid_device_t* dev)
+{
+    hid_setup_state_t* s = &dev->setup;
+
+    // Boot nur für Boot-Mäuse; AUTO zusätzlich nur, wenn dabei keine
+    // Auflösung verloren geht (oder der Deskriptor unbrauchbar ist)
+    s->policy = (uint8_t)device_policy(dev);
+    bool const boot_capable =
+        tuh_hid_interface_protocol(dev->dev_addr, dev->instance) == HID_ITF_PROTOCOL_MOUSE;
+    bool const want_boot = boot_capable &&
+        (s->policy == BOOT_POLICY_ALWAYS ||
+         (s->policy == BOOT_POLICY_AUTO && (!dev->layout_ok || hid_layout_boot_compatible(&dev->layout))));
+
+    s->mode = tuh_hid_get_protocol(dev->dev_addr, dev->instance) == HID_PROTOCOL_BOOT
+            ? HID_MODE_BOOT : HID_MODE_REPORT;
+    s->want = want_boot ? HID_MODE_BOOT : HID_MODE_REPORT;
+    next_step(s, STEP_GET_CONFIG);
+    pending++;
+}
+
+void hid_setup_umount(hid_device_t* dev)
+{
+    hid_setup_state_t* s = &dev->setup;
+    if (s->step == STEP_NONE) return;
+
+    // Beim Abziehen bricht TinyUSB den Transfer ohne Abschluss ab
+    if (config_busy && config_owner == hid_pool_handle(dev)) config_busy = false;
+
+    if (s->step == STEP_RUNNING) stats.mode[s->mode].instances--;
+    else                         pending--;
+    s->step = STEP_NONE;
+}
+
+void hid_setup_service(void)
+{
+    if (!pending) return;
+
+    for (uint32_t i = 0; i < HID_POOL_SIZE; i++) {
+        hid_device_t*      dev = hid_pool_at(i);
+        hid_setup_state_t* s   = &dev->setup;
+        if (!dev->dev_addr) continue;
+
+        // Schritt vor dem Aufruf setzen: der Abschluss kann sofort kommen
+        if (s->step == STEP_GET_CONFIG) {
+            s->step = STEP_WAIT_CONFIG;
+            if (!send_get_config(dev)) {
+                s->step = STEP_GET_CONFIG;
+                if (retry(s)) protocol_or_idle(s);
+            }
+        }
+        if (s->step == STEP_SET_PROTOCOL) {
+            s->step = STEP_WAIT_PROTOCOL;
+            uint8_t const protocol = s->want == HID_MODE_BOOT ? HID_PROTOCOL_BOOT : HID_PROTOCOL_REPORT;
+            if (!tuh_hid_set_protocol(dev->dev_addr, dev->instance, protocol)) {
+                s->step = STEP_SET_PROTOCOL;
+                if (retry(s)) {
+                    stats.setup_failed++;
+                    next_step(s, STEP_SET_IDLE);
+                }
+            }
+        }
+        // kann direkt auf einen sofort abgeschlossenen Wechsel folgen
+        if (s->step == STEP_SET_IDLE) {
+            s->step = STEP_WAIT_IDLE;
+            if (!send_set_idle(dev)) {
+                s->step = STEP_SET_IDLE;
+                if (retry(s)) start_reports(dev);
+            }
+        }
+    }
+}
+
+hid_mode_t hid_setup_mode(hid_device_t const* dev)
+{
+    return (hid_mode_t)dev->setup.mode;
+}
+
+void hid_setup_set_policy(boot_policy_t p)
+{
+    policy = p;
+}
+
+boot_policy_t hid_setup_policy(void)
+{
+    return policy;
+}
+
+void hid_setup_note_report(hid_mode_t mode, uint32_t cycles)
+{
+    hid_mode_stats_t* m = &stats.mode[mode];
+    m->reports++;
+    m->cycles_sum += cycles;
+    if (cycles > m->cycles_max) m->cycles_max = cycles;
+}
+
+hid_setup_stats_t hid_setup_get_stats(void)
+{
+    return stats;
+}
+
+void hid_setup_reset_stats(void)
+{
+    // gemountete Instanzen sind Zustand, keine Statistik
+    for (uint32_t m = 0; m < HID_MODE_COUNT; m++) {
+        stats.mode[m].reports    = 0;
+        stats.mode[m].cycles_sum = 0;
+        stats.mode[m].cycles_max = 0;
+    }
+    stats.setup_retries = 0;
+    stats.setup_failed  = 0;
+}
+
+void hid_setup_print_stats(void)
+{
+    printf("Protocol[policy=%s]:", policy_names[policy]);
+    for (uint32_t m = 0; m < HID_MODE_COUNT; m++) {
+        hid_mode_stats_t const* s = &stats.mode[m];
+        printf(" %s: itf=%lu, reports=%lu, cost avg/max=%lu/%lu " CYCLES_UNIT ";",
+               mode_names[m], (unsigned long)s->instances, (unsigned long)s->reports,
+               (unsigned long)(s->reports ? s->cycles_sum / s->reports : 0),
+               (unsigned long)s->cycles_max);
+    }
+    printf(" setup retries=%lu, failed=%lu\n",
+           (unsigned long)stats.setup_retries, (unsigned long)stats.setup_failed);
+}
@@ -0,0 +1,89 @@
+#ifndef _HID_SETUP_H_
+#define _HID_SETUP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tusb.h"
+#include "hid_layout.h"
+
+// -----------------------------------------------------------------------------
+// Protokollwahl je HID-Instanz nach dem Mount
+//
+// TinyUSB zählt alle Geräte im Report-Protokoll auf. Beim Mount entscheidet
+// eine Policy je Gerät, ob eine Boot-Maus ins Boot-Protokoll geschaltet wird:
+// dann ist die Dekodierung ein fester 3/4-Byte-Pfad. Danach folgt
+// SET_IDLE(0), damit das Gerät nur bei Änderungen sendet. Vorher wird der
+// Konfigurationsdeskriptor gelesen: bInterval für die Rate-Messung.
+//
+// Die Control-Transfers laufen nicht im Mount-Callback (dort zählt TinyUSB
+// noch weitere Interfaces auf), sondern aus hid_setup_service() in der
+// Hauptschleife; ist der Control-Endpunkt belegt, wird es später erneut
+// versucht. Der erste Report wird erst nach SET_IDLE angefordert.
+//
+// ROLAND_BOOT_POLICY: 0 = nie Boot, 1 = nur wenn der Deskriptor ohnehin
+// Boot-Format beschreibt (Standard), 2 = jede Boot-Maus
+// -----------------------------------------------------------------------------
+
+typedef struct hid_device_s hid_device_t;   // hid_pool.h
+
+typedef enum {
+    BOOT_POLICY_NEVER = 0,
+    BOOT_POLICY_AUTO,
+    BOOT_POLICY_ALWAYS,
+} boot_policy_t;
+
+typedef enum {
+    HID_MODE_REPORT = 0,
+    HID_MODE_BOOT,
+    HID_MODE_COUNT
+} hid_mode_t;
+
+// Zustand je Instanz, liegt im Geräte-Pool
+typedef struct {
+    uint8_t step;        // Setup-Schritt (intern)
+    uint8_t mode;        // aktuelles Protokoll (hid_mode_t)
+    uint8_t want;        // Ziel der Policy
+    uint8_t retries;
+    uint8_t policy;      // Policy dieses Geräts (ggf. aus der Quirk-Tabelle)
+} hid_setup_state_t;
+
+typedef struct {
+    uint32_t instances;  // gemountete Instanzen in diesem Modus
+    uint32_t reports;    // dekodierte Mausreports
+    uint64_t cycles_sum; // Kosten der Report-Verarbeitung (CYCLES_UNIT)
+    uint32_t cycles_max;
+} hid_mode_stats_t;
+
+typedef struct {
+    hid_mode_stats_t mode[HID_MODE_COUNT];
+    uint32_t         setup_retries;  // Control-Endpunkt belegt
+    uint32_t         setup_failed;   // SET_PROTOCOL abgelehnt oder aufgegeben
+} hid_setup_stats_t;
+
+// Vor tusb_init() aufrufen
+void hid_setup_init(void);
+
+// Aus tuh_hid_mount_cb, Plan steht schon im Eintrag: Policy anwenden und
+// Konfiguration vormerken
+void hid_setup_mount(hid_device_t* dev);
+void hid_setup_umount(hid_device_t* dev);
+
+// Hauptschleife: vorgemerkte Control-Transfers starten
+void hid_setup_service(void);
+
+// Aktuelles Protokoll der Instanz (Report-Callback)
+hid_mode_t hid_setup_mode(hid_device_t const* dev);
+
+// Laufzeit-Umschaltung der Policy (gilt ab dem nächsten Mount)
+void          hid_setup_set_policy(boot_policy_t policy);
+boot_policy_t hid_setup_policy(void);
+
+// Kosten der Verarbeitung eines Reports verbuchen
+void hid_setup_note_report(hid_mode_t mode, uint32_t cycles);
+
+hid_setup_stats_t hid_setup_get_stats(void);
+void hid_setup_reset_stats(void);
+void hid_setup_print_stats(void);
+
+#endif
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <atomic>
+
+#include "latency.h"
+
+#ifndef ROLAND_LATENCY_BUCKET_US
+#define ROLAND_LATENCY_BUCKET_US 250
+#endif
+
+#ifndef ROLAND_LATENCY_BUCKETS
+#define ROLAND_LATENCY_BUCKETS 128   // 32 ms bei 250 µs; darüber: letzter Bucket
+#endif
+
+#define ARRIVAL_RING 64
+
+// Eingangszeiten noch nicht ausgegebener Reports (SPSC, siehe latency.h)
+static uint32_t              arrival[ARRIVAL_RING];
+static std::atomic<uint32_t> head{0};
+static uint32_t              tail;
+static uint32_t              snap_head;
+
+typedef struct {
+    volatile uint32_t bucket[ROLAND_LATENCY_BUCKETS];
+    volatile uint32_t count;
+    volatile uint32_t min_us;
+    volatile uint32_t max_us;
+    volatile bool     reset_request;   // ausgeführt vom Schreiber
+} histogram_t;
+
+// Je Histogramm schreibt nur ein Kontext: Bewegung der Consumer (PIO-IRQ),
+// Tasten der Report-Pfad
+static histogram_t motion_hist = { {}, 0, UINT32_MAX, 0, false };
+static histogram_t button_hist = { {}, 0, UINT32_MAX, 0, false };
+static volatile uint32_t overflow;
+
+static void hist_clear(histogram_t* h)
+{
+    for (uint32_t i = 0; i < ROLAND_LATENCY_BUCKETS; i++) h->bucket[i] = 0;
+    h->count  = 0;
+    h->min_us = UINT32_MAX;
+    h->max_us = 0;
+}
+
+static void hist_add(histogram_t* h, uint32_t lat)
+{
+    uint32_t bucket = lat / ROLAND_LATENCY_BUCKET_US;
+    if (bucket >= ROLAND_LATENCY_BUCKETS) bucket = ROLAND_LATENCY_BUCKETS - 1;
+    h->bucket[bucket]++;
+    h->count++;
+    if (lat < h->min_us) h->min_us = lat;
+    if (lat > h->max_us) h->max_us = lat;
+}
+
+void latency_motion_added(uint32_t arrival_us)
+{
+    uint32_t h = head.load(std::memory_order_relaxed);
+    arrival[h % ARRIVAL_RING] = arrival_us;
+    head.store(h + 1, std::memory_order_release);
+}
+
+void latency_snapshot(void)
+{
+    snap_head = head.load(std::memory_order_acquire);
+}
+
+void latency_delivered(uint32_t now_us, bool carry)
+{
+    if (motion_hist.reset_request) {
+        hist_clear(&motion_hist);
+        overflow = 0;
+        motion_hist.reset_request = false;
+    }
+
+    if (tail == snap_head) return;   // Snapshot enthielt keine neue Bewegung
+
+    // Producer war mehr als einen Ring voraus: älteste Zeiten sind überschrieben
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (h - tail > ARRIVAL_RING) {
+        tail = h - ARRIVAL_RING;
+        if ((int32_t)(snap_head - tail) < 0) snap_head = tail;
+        overflow++;
+    }
+
+    hist_add(&motion_hist, now_us - arrival[tail % ARRIVAL_RING]);
+
+    // Mit Übertrag bleibt die älteste Bewegung offen und altert weiter
+    if (!carry) tail = snap_head;
+}
+
+void latency_button_edge(uint32_t arrival_us, uint32_t now_us)
+{
+    if (button_hist.reset_request) {
+        hist_clear(&button_hist);
+        button_hist.reset_request = false;
+    }
+    hist_add(&button_hist, now_us - arrival_us);
+}
+
+static uint32_t percentile(histogram_t const* h, uint32_t total, uint32_t pct)
+{
+    uint32_t want = (uint32_t)(((uint64_t)total * pct + 99) / 100);
+    uint32_t sum  = 0;
+    for (uint32_t i = 0; i < ROLAND_LATENCY_BUCKETS; i++) {
+        sum += h->bucket[i];
+        if (sum >= want) return (i + 1) * ROLAND_LATENCY_BUCKET_US;
+    }
+    return ROLAND_LATENCY_BUCKETS * ROLAND_LATENCY_BUCKET_US;
+}
+
+static latency_summary_t summary_of(histogram_t const* h)
+{
+    latency_summary_t s;
+    s.count    = h->count;
+    s.min_us   = s.count ? h->min_us : 0;
+    s.max_us   = h->max_us;
+    s.p50_us   = s.count ? percentile(h, s.count, 50) : 0;
+    s.p99_us   = s.count ? percentile(h, s.count, 99) : 0;
+    s.overflow = 0;
+    return s;
+}
+
+latency_summary_t latency_get_summary(void)
+{
+    latency_summary_t s = summary_of(&motion_hist);
+    s.overflow = overflow;
+    return s;
+}
+
+latency_summary_t latency_get_button_summary(void)
+{
+    return summary_of(&button_hist);
+}
+
+void latency_reset(void)
+{
+    // Ausgeführt vom jeweiligen Schreiber beim nächsten Messwert
+    motion_hist.reset_request = true;
+    button_hist.reset_request = true;
+}
+
+static void print_histogram(char const* what, histogram_t const* h, latency_summary_t const* s)
+{
+    printf("Latency %s: n=%lu, min=%lu us, p50<=%lu us, p99<=%lu us, max=%lu us, overflow=%lu\n", what,
+           (unsigned long)s->count, (unsigned long)s->min_us, (unsigned long)s->p50_us,
+           (unsigned long)s->p99_us, (unsigned long)s->max_us, (unsigned long)s->overflow);
+
+    for (uint32_t i = 0; i < ROLAND_LATENCY_BUCKETS; i++) {
+        if (!h->bucket[i]) continue;
+        printf("  %s%5lu us: %lu\n", i == ROLAND_LATENCY_BUCKETS - 1 ? ">=" : "< ",
+               (unsigned long)((i == ROLAND_LATENCY_BUCKETS - 1 ? i : i + 1) * ROLAND_LATENCY_BUCKET_US),
+               (unsigned long)h->bucket[i]);
+    }
+}
+
+void latency_print(void)
+{
+    latency_summary_t const motion = latency_get_summary();
+    latency_summary_t const button = latency_get_button_summary();
+    print_histogram("report->read", &motion_hist, &motion);
+    print_histogram("report->button", &button_hist, &button);
+}
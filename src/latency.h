@@ -0,0 +1,49 @@
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// End-to-End-Latenz: Report-Eingang (tuh_hid_report_received_cb) bis zu dem
+// Lesezyklus, der die Bewegung an den Sampler ausgibt
+//
+// Gemessen wird das Alter der ältesten noch nicht vollständig ausgegebenen
+// Bewegung zum Zeitpunkt der Ausgabe. Die Werte landen in einem Histogramm
+// mit festen Buckets (ROLAND_LATENCY_BUCKET_US breit).
+//
+// latency_motion_added() läuft im Kontext, der in den Akkumulator addiert;
+// die übrigen Funktionen im Kontext des Ausgangs (PIO-IRQ).
+//
+// Tasten gehen am Lesezyklus vorbei direkt auf die Trigger-Pins (siehe
+// msx_buttons.h); jede Flanke dort landet mit dem Alter ihres Reports in
+// einem eigenen Histogramm.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t p50_us;   // Obergrenze des Buckets
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t overflow; // Ring der Eingangszeiten übergelaufen
+} latency_summary_t;
+
+// Producer: Bewegung mit diesem Eingangszeitpunkt wurde addiert
+void latency_motion_added(uint32_t arrival_us);
+
+// Consumer: neuer Snapshot gebildet (enthält alle bisher addierten Reports)
+void latency_snapshot(void);
+
+// Consumer: Snapshot ausgegeben; carry = danach steht noch Bewegung aus
+void latency_delivered(uint32_t now_us, bool carry);
+
+// Report-Pfad: Trigger-Pin hat zum Report mit diesem Eingang umgeschaltet
+void latency_button_edge(uint32_t arrival_us, uint32_t now_us);
+
+latency_summary_t latency_get_summary(void);
+latency_summary_t latency_get_button_summary(void);
+void latency_reset(void);
+void latency_print(void);
+
+#endif
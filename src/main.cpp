@@ -4,22 +4,74 @@
 #include "tusb.h"
 #include "class/hid/hid_host.h" // für HID Host-Funktionen
 
+#include "boot_record.h"
+#include "console.h"
+#include "cycles.h"
+#include "hid_pool.h"
+#include "hid_reports.h"
+#include "hid_setup.h"
+#include "mouse_merge.h"
+#include "output_task.h"
+#include "scheduler.h"
+#include "settings.h"
+#include "trace.h"
+
+// Board, stdio und Startmeldung erst nach dem ersten Report (oder Timeout)
+#ifndef ROLAND_FAST_START
+#define ROLAND_FAST_START 0
+#endif
+
+#ifndef ROLAND_FAST_START_TIMEOUT_MS
+#define ROLAND_FAST_START_TIMEOUT_MS 3000
+#endif
+
+// Zustand einer Instanz abbauen (Unmount oder verpasster Unmount)
+static void device_release(uint8_t dev_addr, uint8_t instance)
+{
+    hid_device_t* dev = hid_pool_find(dev_addr, instance);
+    if (!dev) return;
+
+    hid_setup_umount(dev);
+    mouse_merge_detach(dev);
+    hid_pool_release(dev_addr, instance);
+}
+
 // -----------------------------------------------------------------------------
 // Callback: HID-Gerät (z. B. Maus) wurde erkannt
 // -----------------------------------------------------------------------------
 void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t instance,
                       uint8_t const* desc_report, uint16_t desc_len)
 {
-    (void) desc_report;
-    (void) desc_len;
-
+    boot_mark(BOOT_MOUNT);
     uint16_t vid, pid;
     tuh_vid_pid_get(dev_addr, &vid, &pid);
     printf("HID device connected: addr=%u, instance=%u, VID=%04x, PID=%04x\n",
            dev_addr, instance, vid, pid);
+    trace_event(TRACE_MOUNT, dev_addr, instance);
+
+    // Zustand aus dem statischen Pool; wird eine Adresse ohne Unmount
+    // wiederverwendet, zuerst den alten Eintrag abbauen
+    device_release(dev_addr, instance);
+    hid_device_t* dev = hid_pool_claim(dev_addr, instance);
+    if (!dev) {
+        printf("HID device ignored: no free slot\n");
+        return;
+    }
+
+    // Extraktionsplan und Verteilung nach Report-ID einmalig beim Mount
+    // erstellen; beide gelten für das Report-Protokoll. Anhand des Plans
+    // entscheidet hid_setup, ob die Instanz ins Boot-Protokoll wechselt, und
+    // fordert dort auch den ersten Report an.
+    dev->layout_ok = hid_layout_parse(&dev->layout, &dev->dispatch, desc_report, desc_len);
+    printf("HID layout: %s, report_id=%u, len>=%u\n",
+           dev->layout_ok ? "mouse" : "none", dev->layout.report_id, dev->layout.min_len);
+
+    // Mäuse werden Quellen des gemeinsamen Bewegungsstroms
+    if (dev->layout_ok || tuh_hid_interface_protocol(dev_addr, instance) == HID_ITF_PROTOCOL_MOUSE) {
+        mouse_merge_attach(dev);
+    }
 
-    // ersten Report anfordern
-    tuh_hid_receive_report(dev_addr, instance);
+    hid_setup_mount(dev);
 }
 
 // -----------------------------------------------------------------------------
@@ -27,7 +79,9 @@ void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t instance,
 // -----------------------------------------------------------------------------
 void tuh_hid_umount_cb(uint8_t dev_addr, uint8_t instance)
 {
+    device_release(dev_addr, instance);
     printf("HID device disconnected: addr=%u, instance=%u\n", dev_addr, instance);
+    trace_event(TRACE_UMOUNT, dev_addr, instance);
 }
 
 // -----------------------------------------------------------------------------
@@ -36,33 +90,83 @@ void tuh_hid_umount_cb(uint8_t dev_addr, uint8_t instance)
 void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t instance,
                                 uint8_t const* report, uint16_t len)
 {
-    (void) len;
+    // Kopieren und neu anfordern; verarbeitet wird in der Hauptschleife
+    hid_reports_receive(dev_addr, instance, report, len);
+    scheduler_note_report();
+    boot_mark(BOOT_FIRST_REPORT);
+}
 
-    // Cast auf vorhandene TinyUSB-Struktur
-    hid_mouse_report_t const* mouse = (hid_mouse_report_t const*)report;
+// -----------------------------------------------------------------------------
+// Setup + Mainloop (im Host-Build stellt der Benchmark main() bereit)
+// -----------------------------------------------------------------------------
+#ifndef ROLAND_HOST_BUILD
+static void board_start(void)
+{
+    board_init();
+    boot_mark(BOOT_BOARD);
+}
 
-    printf("Mouse: buttons=%02x, x=%d, y=%d, wheel=%d\n",
-           mouse->buttons, mouse->x, mouse->y, mouse->wheel);
+#if ROLAND_FAST_START
+// Bis der Cursor läuft, kosten Ausgaben auf der UART nur Zeit: Meldungen aus
+// Mount und Setup gehen ohne stdio ins Leere. Ohne Maus kommt die Konsole
+// nach dem Timeout.
+static void deferred_start(void)
+{
+    if (boot_reached(BOOT_STDIO)) return;
+    if (!boot_reached(BOOT_FIRST_REPORT) &&
+        time_us_32() - boot_get_record().at_us[BOOT_LOOP] < ROLAND_FAST_START_TIMEOUT_MS * 1000u) return;
 
-    // Nächsten Report anfordern
-    tuh_hid_receive_report(dev_addr, instance);
+    board_start();
+    stdio_init_all();
+    printf("TinyUSB HID Host Beispiel gestartet. '?' fuer Kommandos.\n");
+    boot_mark(BOOT_STDIO);
+    boot_print();
 }
+#endif
 
-// -----------------------------------------------------------------------------
-// Setup + Mainloop
-// -----------------------------------------------------------------------------
 int main()
 {
+#if !ROLAND_FAST_START
     stdio_init_all();
-    board_init();
+    board_start();
+#endif
+    cycles_init();
+    hid_setup_init();
     tusb_init();
+    boot_mark(BOOT_TUSB);
+    output_task_start();
+    boot_mark(BOOT_OUTPUT);
+    settings_init();       // gespeicherte Einstellungen, nach dem Ausgang
+    boot_mark(BOOT_SETTINGS);
+    scheduler_init();
 
-    printf("TinyUSB HID Host Beispiel gestartet.\n");
+#if !ROLAND_FAST_START
+    printf("TinyUSB HID Host Beispiel gestartet. '?' fuer Kommandos.\n");
+    boot_mark(BOOT_STDIO);
+#endif
+    boot_mark(BOOT_LOOP);
 
     while (true) {
-        tuh_task();  // USB Host Aufgaben
-        sleep_ms(10);
+        scheduler_wait();      // schläft, bis USB-Host-Arbeit ansteht
+        tuh_task();            // USB Host Aufgaben
+        scheduler_task_done();
+        hid_reports_service(); // empfangene Reports dekodieren und ausgeben
+        output_task_service(); // Rest aus voller Queue an Core1
+        hid_setup_service();   // Protokoll/Idle nach dem Mount setzen
+
+        // Leerlaufarbeit: nie blockierend, damit USB immer Vorrang hat
+#if ROLAND_FAST_START
+        deferred_start();
+#endif
+        // Trace und Konsole greifen direkt auf die UART zu: erst nach
+        // board_init()/stdio_init_all(), vorher ist sie noch im Reset
+        if (boot_reached(BOOT_STDIO)) {
+            trace_service();
+            console_service();
+        }
+        settings_service();    // Flash nur in Ruhe, ein Vorgang je Durchlauf
     }
 
     return 0;
 }
+#endif
@@ -0,0 +1,75 @@
+#ifndef _MOTION_ACCUMULATOR_H_
+#define _MOTION_ACCUMULATOR_H_
+
+#include <stdint.h>
+#include <atomic>
+
+// -----------------------------------------------------------------------------
+// Verlustfreier Bewegungsakkumulator
+//
+// Statt eines gemeinsamen Zählers, der von beiden Seiten verändert wird,
+// führt jede Seite ihre eigene monoton laufende Summe:
+//   Producer (USB-Seite):  added  += dx
+//   Consumer (Ausgabe):    taken  += ausgegebener Wert
+// Ausstehend ist immer added - taken (modulo 2^32, daher überlaufsicher).
+// Beide Seiten schreiben nur eigene Variablen und lesen die der anderen:
+// wait-free, ohne Interrupt-Sperre und ohne Read-Modify-Write-Befehle.
+//
+// Der Consumer gibt pro Lesevorgang höchstens "limit" aus; der Rest bleibt
+// einfach stehen und wird beim nächsten Lesen mitgenommen.
+// -----------------------------------------------------------------------------
+
+class MotionAccumulator {
+public:
+    // --- Producer (genau ein Kontext) ---------------------------------------
+    void add(int32_t dx, int32_t dy)
+    {
+        added_x_.store(added_x_.load(std::memory_order_relaxed) + (uint32_t)dx, std::memory_order_release);
+        added_y_.store(added_y_.load(std::memory_order_relaxed) + (uint32_t)dy, std::memory_order_release);
+    }
+
+    // --- Consumer (genau ein Kontext) ---------------------------------------
+    int32_t pending_x() const { return pending(added_x_, taken_x_); }
+    int32_t pending_y() const { return pending(added_y_, taken_y_); }
+
+    // Nächster Ausschnitt, auf +-limit begrenzt, ohne ihn zu verbrauchen
+    void peek(int32_t limit, int32_t& x, int32_t& y) const
+    {
+        x = clamp(pending_x(), limit);
+        y = clamp(pending_y(), limit);
+    }
+
+    // Tatsächlich ausgegebene Werte verbuchen
+    void consume(int32_t x, int32_t y)
+    {
+        taken_x_.store(taken_x_.load(std::memory_order_relaxed) + (uint32_t)x, std::memory_order_release);
+        taken_y_.store(taken_y_.load(std::memory_order_relaxed) + (uint32_t)y, std::memory_order_release);
+    }
+
+    // peek() + consume() für Ausgänge ohne Rückmeldung
+    void take(int32_t limit, int32_t& x, int32_t& y)
+    {
+        peek(limit, x, y);
+        consume(x, y);
+    }
+
+private:
+    static int32_t pending(std::atomic<uint32_t> const& added, std::atomic<uint32_t> const& taken)
+    {
+        return (int32_t)(added.load(std::memory_order_acquire) - taken.load(std::memory_order_relaxed));
+    }
+
+    static int32_t clamp(int32_t v, int32_t limit)
+    {
+        if (v >  limit) return  limit;
+        if (v < -limit) return -limit;
+        return v;
+    }
+
+    std::atomic<uint32_t> added_x_{0};
+    std::atomic<uint32_t> added_y_{0};
+    std::atomic<uint32_t> taken_x_{0};
+    std::atomic<uint32_t> taken_y_{0};
+};
+
+#endif
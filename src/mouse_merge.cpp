@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+#include "hid_pool.h"
+#include "mouse_merge.h"
+#include "output_task.h"
+
+#ifndef ROLAND_MERGE_POLICY
+#define ROLAND_MERGE_POLICY 0
+#endif
+
+// Ruhezeit, nach der eine andere Maus übernehmen darf
+#ifndef ROLAND_MERGE_HOLD_MS
+#define ROLAND_MERGE_HOLD_MS 300
+#endif
+
+#define NO_SOURCE 0xFF
+
+// Quellen als Pool-Index
+static uint8_t  pressed[8];            // Anzahl Mäuse je gedrückter Taste
+static uint8_t  current = NO_SOURCE;   // Maus, die zuletzt ausgegeben hat
+static uint8_t  primary = NO_SOURCE;   // älteste angeschlossene Maus
+static uint32_t mount_seq;
+
+static merge_policy_t      policy = (merge_policy_t)ROLAND_MERGE_POLICY;
+static mouse_merge_stats_t stats;
+
+static char const* const policy_names[] = { "sum", "last-active", "primary" };
+
+static inline merge_source_t* source_at(uint8_t idx)
+{
+    return &hid_pool_at(idx)->merge;
+}
+
+// Tastenzähler nachführen: nur geänderte Bits, höchstens 8 Schritte
+static void set_buttons(merge_source_t* s, uint8_t buttons)
+{
+    uint8_t changed = s->buttons ^ buttons;
+    for (uint8_t b = 0; changed; b++, changed >>= 1) {
+        if (!(changed & 1)) continue;
+        if ((buttons >> b) & 1) pressed[b]++;
+        else                    pressed[b]--;
+    }
+    s->buttons = buttons;
+}
+
+static uint8_t buttons_sum(void)
+{
+    uint8_t mask = 0;
+    for (uint8_t b = 0; b < 8; b++) {
+        if (pressed[b]) mask |= (uint8_t)(1u << b);
+    }
+    return mask;
+}
+
+static uint8_t buttons_out(void)
+{
+    if (policy == MERGE_SUM) return buttons_sum();
+    return current != NO_SOURCE ? source_at(current)->buttons : 0;
+}
+
+// Die Maus mit Vorrang ist aktiv: bewegt oder hält eine Taste
+static bool holds(uint8_t idx, uint32_t now_us)
+{
+    if (idx == NO_SOURCE) return false;
+    merge_source_t const* s = source_at(idx);
+    return s->buttons || (now_us - s->last_us) < ROLAND_MERGE_HOLD_MS * 1000u;
+}
+
+void mouse_merge_attach(hid_device_t* dev)
+{
+    merge_source_t* s = &dev->merge;
+    if (s->order) return;
+
+    s->order   = ++mount_seq;
+    s->last_us = time_us_32() - ROLAND_MERGE_HOLD_MS * 1000u;
+    s->buttons = 0;
+    if (primary == NO_SOURCE) primary = (uint8_t)hid_pool_index(dev);
+    stats.sources++;
+}
+
+void mouse_merge_detach(hid_device_t* dev)
+{
+    merge_source_t* s = &dev->merge;
+    if (!s->order) return;
+
+    uint8_t const idx = (uint8_t)hid_pool_index(dev);
+    set_buttons(s, 0);
+    s->order = 0;
+    stats.sources--;
+    if (current == idx) current = NO_SOURCE;
+
+    if (primary == idx) {
+        // älteste verbleibende Maus wird Primärmaus
+        primary = NO_SOURCE;
+        uint32_t oldest = UINT32_MAX;
+        for (uint8_t i = 0; i < HID_POOL_SIZE; i++) {
+            merge_source_t const* o = source_at(i);
+            if (hid_pool_at(i)->dev_addr && o->order && o->order < oldest) {
+                oldest  = o->order;
+                primary = i;
+            }
+        }
+    }
+
+    // Tasten der getrennten Maus dürfen nicht gedrückt bleiben
+    output_task_post(0, 0, buttons_out(), time_us_32());
+}
+
+void mouse_merge_report(hid_device_t* dev, int32_t dx, int32_t dy,
+                        uint8_t buttons, uint32_t arrival_us)
+{
+    merge_source_t* s = &dev->merge;
+    if (!s->order) return;
+
+    uint8_t const idx = (uint8_t)hid_pool_index(dev);
+    bool const active = dx || dy || buttons != s->buttons;
+    set_buttons(s, buttons);
+    if (active) s->last_us = arrival_us;
+
+    if (policy != MERGE_SUM) {
+        uint8_t const holder = policy == MERGE_PRIMARY ? primary : current;
+        if (idx != holder) {
+            if (!active) return;   // Leerlauf-Reports anderer Mäuse ändern nichts
+            if (holds(holder, arrival_us)) {
+                stats.dropped++;
+                return;
+            }
+        }
+        if (idx != current) {
+            current = idx;
+            stats.switches++;
+        }
+    }
+
+    stats.merged++;
+    output_task_post(dx, dy, buttons_out(), arrival_us);
+}
+
+void mouse_merge_set_policy(merge_policy_t p)
+{
+    policy  = p;
+    current = NO_SOURCE;
+}
+
+merge_policy_t mouse_merge_policy(void)
+{
+    return policy;
+}
+
+mouse_merge_stats_t mouse_merge_get_stats(void)
+{
+    return stats;
+}
+
+void mouse_merge_reset_stats(void)
+{
+    stats.merged   = 0;
+    stats.dropped  = 0;
+    stats.switches = 0;
+}
+
+void mouse_merge_print_stats(void)
+{
+    printf("Merge[%s]: mice=%lu, merged=%lu, dropped=%lu, switches=%lu\n",
+           policy_names[policy], (unsigned long)stats.sources, (unsigned long)stats.merged,
+           (unsigned long)stats.dropped, (unsigned long)stats.switches);
+}
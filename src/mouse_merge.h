@@ -0,0 +1,61 @@
+#ifndef _MOUSE_MERGE_H_
+#define _MOUSE_MERGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Zusammenführen mehrerer Mäuse (z. B. am Hub) zu einem Bewegungsstrom
+//
+// Jede gemountete Maus-Instanz ist eine Quelle; ihr Zustand liegt im
+// Eintrag des Geräte-Pools (hid_pool.h). Policies:
+//
+//   sum          Bewegung aller Mäuse addieren, Tasten ODER-verknüpfen
+//   last-active  die zuletzt bewegte Maus gewinnt; eine andere übernimmt erst,
+//                wenn die aktive ROLAND_MERGE_HOLD_MS ruhig war und keine
+//                Taste hält
+//   primary      die zuerst gemountete Maus hat immer Vorrang, die übrigen
+//                nur, solange sie ruht
+//
+// Pro Report ist der Aufwand konstant, unabhängig von der Anzahl der Mäuse.
+// Nur beim Trennen der Primärmaus wird der Pool einmal durchsucht.
+// -----------------------------------------------------------------------------
+
+typedef struct hid_device_s hid_device_t;   // hid_pool.h
+
+// Zustand je Quelle, liegt im Geräte-Pool
+typedef struct {
+    uint32_t order;     // Mount-Reihenfolge, 0 = keine Maus
+    uint32_t last_us;   // letzte Bewegung oder Tastenänderung
+    uint8_t  buttons;
+} merge_source_t;
+
+typedef enum {
+    MERGE_SUM = 0,
+    MERGE_LAST_ACTIVE,
+    MERGE_PRIMARY,
+    MERGE_POLICY_COUNT
+} merge_policy_t;
+
+typedef struct {
+    uint32_t sources;   // angeschlossene Mäuse
+    uint32_t merged;    // weitergegebene Reports
+    uint32_t dropped;   // verworfen, weil eine andere Maus aktiv war
+    uint32_t switches;  // Wechsel der aktiven Maus
+} mouse_merge_stats_t;
+
+void mouse_merge_attach(hid_device_t* dev);
+void mouse_merge_detach(hid_device_t* dev);
+
+// Aus dem Report-Callback; gibt das Ergebnis an output_task_post() weiter
+void mouse_merge_report(hid_device_t* dev, int32_t dx, int32_t dy,
+                        uint8_t buttons, uint32_t arrival_us);
+
+void           mouse_merge_set_policy(merge_policy_t policy);
+merge_policy_t mouse_merge_policy(void);
+
+mouse_merge_stats_t mouse_merge_get_stats(void);
+void mouse_merge_reset_stats(void);
+void mouse_merge_print_stats(void);
+
+#endif
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+
+#include "latency.h"
+#include "msx_buttons.h"
+#include "pin_masks.h"
+#include "pins.h"
+
+// 0 = aus: USB-Mäuse entprellen selbst
+#ifndef ROLAND_BUTTON_DEBOUNCE_US
+#define ROLAND_BUTTON_DEBOUNCE_US 0
+#endif
+
+static_assert(MOUSE_BUTTON_LEFT == 1 && MOUSE_BUTTON_RIGHT == 2, "Tasten-Bits = Index der Trigger-Tabelle");
+
+static uint8_t  raw;            // zuletzt gemeldete HID-Tasten
+static uint8_t  out;            // Stand an den Pins (Bit 0 A, Bit 1 B)
+static uint32_t raw_arrival_us;
+
+static msx_buttons_stats_t stats;
+
+#if ROLAND_BUTTON_DEBOUNCE_US
+static uint32_t          edge_us[2];   // letzte Flanke je Taste
+static repeating_timer_t timer;
+#endif
+
+// Neuen Pin-Stand aus raw bilden und schreiben; im Report-Pfad mit
+// gesperrten Interrupts, im Timer ohnehin exklusiv auf diesem Core
+static void apply(uint32_t now_us)
+{
+    uint8_t const want = raw & (MOUSE_BUTTON_LEFT | MOUSE_BUTTON_RIGHT);
+    uint8_t next = want;
+
+#if ROLAND_BUTTON_DEBOUNCE_US
+    uint8_t const changed = (uint8_t)(want ^ out);
+    for (uint8_t b = 0; b < 2; b++) {
+        uint8_t const bit = (uint8_t)(1u << b);
+        if (!(changed & bit)) continue;
+        if (now_us - edge_us[b] < ROLAND_BUTTON_DEBOUNCE_US) {
+            next = (uint8_t)((next & ~bit) | (out & bit));   // im Fenster: alten Stand halten
+            continue;
+        }
+        edge_us[b] = now_us;
+    }
+#endif
+
+    if (next == out) return;
+    out = next;
+    gpio_put_masked(MSX_TRIG_MASK, msx_trigger_levels(next));
+    stats.edges++;
+    latency_button_edge(raw_arrival_us, now_us);
+}
+
+#if ROLAND_BUTTON_DEBOUNCE_US
+static bool debounce_tick(repeating_timer_t* rt)
+{
+    (void)rt;
+    if ((raw & (MOUSE_BUTTON_LEFT | MOUSE_BUTTON_RIGHT)) != out) apply(time_us_32());
+    return true;
+}
+#endif
+
+void msx_buttons_init(void)
+{
+    gpio_init(PIN_MSX_TRIG_A);
+    gpio_init(PIN_MSX_TRIG_B);
+    gpio_set_dir(PIN_MSX_TRIG_A, GPIO_OUT);
+    gpio_set_dir(PIN_MSX_TRIG_B, GPIO_OUT);
+    raw = 0;
+    out = 0;
+    gpio_put_masked(MSX_TRIG_MASK, msx_trigger_levels(0));
+
+#if ROLAND_BUTTON_DEBOUNCE_US
+    // Halbes Fenster: zurückgehaltene Wechsel folgen spätestens 1,5 Fenster nach der Flanke
+    add_repeating_timer_us(ROLAND_BUTTON_DEBOUNCE_US / 2, debounce_tick, nullptr, &timer);
+#endif
+}
+
+void msx_buttons_write(uint8_t buttons, uint32_t arrival_us)
+{
+#if ROLAND_BUTTON_DEBOUNCE_US
+    uint32_t const irq = save_and_disable_interrupts();
+    if (buttons != raw) {
+        raw            = buttons;
+        raw_arrival_us = arrival_us;
+        uint8_t const before = out;
+        apply(time_us_32());
+        if ((raw & (MOUSE_BUTTON_LEFT | MOUSE_BUTTON_RIGHT)) != out && out == before) stats.suppressed++;
+    }
+    restore_interrupts(irq);
+#else
+    if (buttons == raw) return;
+    raw            = buttons;
+    raw_arrival_us = arrival_us;
+    apply(time_us_32());
+#endif
+}
+
+msx_buttons_stats_t msx_buttons_get_stats(void)
+{
+    return stats;
+}
+
+void msx_buttons_reset_stats(void)
+{
+    stats = msx_buttons_stats_t{};
+}
+
+void msx_buttons_print_stats(void)
+{
+    printf("Buttons: direct, edges=%lu, debounce=%lu us, suppressed=%lu\n",
+           (unsigned long)stats.edges, (unsigned long)ROLAND_BUTTON_DEBOUNCE_US,
+           (unsigned long)stats.suppressed);
+}
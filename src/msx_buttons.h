@@ -0,0 +1,36 @@
+#ifndef _MSX_BUTTONS_H_
+#define _MSX_BUTTONS_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Trigger A/B direkt aus dem Report-Pfad
+//
+// Tasten gehören nicht zum Nibble-Snapshot: der Sampler liest die Trigger-
+// Pins jederzeit. Deshalb schreibt der Report-Pfad sie sofort, mit einem
+// maskierten SIO-Zugriff für beide Pins (pin_masks.h), unabhängig vom
+// Ausgangsprotokoll und ohne Umweg über die Queue zu Core1. Jede Pin-Flanke geht mit dem
+// Alter des auslösenden Reports in das Tasten-Histogramm (latency.h).
+//
+// Optional (ROLAND_BUTTON_DEBOUNCE_US > 0) je Taste entprellt: die erste
+// Flanke gilt sofort, weitere Wechsel erst nach Ablauf des Fensters; ein
+// Timer übernimmt den letzten Stand, falls danach kein Report mehr kommt.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t edges;       // Flanken an den Trigger-Pins
+    uint32_t suppressed;  // Wechsel, die im Entprellfenster zurückgehalten wurden
+} msx_buttons_stats_t;
+
+// Auf dem Core des Report-Pfads aufrufen (Timer für das Entprellen)
+void msx_buttons_init(void);
+
+// HID-Tasten (Bit 0 links, Bit 1 rechts) auf Trigger A/B, aktiv low;
+// arrival_us = Eingang des Reports
+void msx_buttons_write(uint8_t buttons, uint32_t arrival_us);
+
+msx_buttons_stats_t msx_buttons_get_stats(void);
+void msx_buttons_reset_stats(void);
+void msx_buttons_print_stats(void);
+
+#endif
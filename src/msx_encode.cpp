@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#include "cycles.h"
+#include "msx_encode.h"
+
+#define BENCH_SAMPLES 256
+
+int32_t msx_encode_limit = MSX_READ_LIMIT;
+
+void msx_encode_init(int32_t limit)
+{
+    if (limit > MSX_READ_LIMIT) limit = MSX_READ_LIMIT;
+    msx_encode_limit = limit;
+
+    // interp1 Lane 0: ACCUM0 unverändert, vorzeichenbehaftet auf BASE0..BASE1
+    // (Clamp gibt es nur auf interp1)
+    interp_config clamp = interp_default_config();
+    interp_config_set_clamp(&clamp, true);
+    interp_config_set_signed(&clamp, true);
+    interp_config_set_shift(&clamp, 0);
+    interp_config_set_mask(&clamp, 0, 31);
+    interp_set_config(interp1, 0, &clamp);
+    interp_set_base(interp1, 0, (uint32_t)-limit);
+    interp_set_base(interp1, 1, (uint32_t)limit);
+
+    // interp0: Lane 0 liefert X (Bits 0-7), Lane 1 Y (Bits 8-15), jeweils
+    // mit vertauschten Nibbles; das volle Ergebnis ist der Snapshot
+    interp_config swap = interp_default_config();
+    interp_config_set_shift(&swap, 4);
+    interp_config_set_mask(&swap, 0, 7);
+    interp_set_config(interp0, 0, &swap);
+    interp_config_set_mask(&swap, 8, 15);
+    interp_set_config(interp0, 1, &swap);
+    interp_set_base(interp0, 0, 0);
+    interp_set_base(interp0, 1, 0);
+    interp_set_base(interp0, 2, 0);
+}
+
+void msx_encode_bench(void)
+{
+    static int32_t xs[BENCH_SAMPLES];
+    static int32_t ys[BENCH_SAMPLES];
+
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = (int32_t)((seed >> 8) % 601) - 300;
+        ys[i] = (int32_t)((seed >> 20) % 601) - 300;
+    }
+    xs[0] = INT32_MAX;
+    ys[0] = INT32_MIN;
+    xs[1] = -MSX_READ_LIMIT - 1;
+    ys[1] = MSX_READ_LIMIT + 1;
+
+    // Auf Core0 ohne Multicore nutzt der PIO-IRQ dieselben Interpolatoren
+    uint32_t const irq = save_and_disable_interrupts();
+    int32_t const limit = msx_encode_limit;
+    msx_encode_init(limit);
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        if (msx_encode_interp(xs[i], ys[i]) != msx_encode_soft(xs[i], ys[i], limit)) mismatches++;
+    }
+
+    volatile uint32_t sink = 0;
+    uint32_t acc = 0;
+    uint32_t start = cycles_now();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) acc ^= msx_encode_soft(xs[i], ys[i], limit);
+    uint32_t const soft = cycles_since(start);
+    sink = acc;
+
+    acc   = 0;
+    start = cycles_now();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) acc ^= msx_encode_interp(xs[i], ys[i]);
+    uint32_t const interp = cycles_since(start);
+    sink = acc;
+    (void)sink;
+
+    restore_interrupts(irq);
+
+    printf("Encode[%s]: C %lu.%02lu, interp %lu.%02lu " CYCLES_UNIT "/snapshot, %lu mismatches\n",
+           ROLAND_MSX_INTERP ? "interp" : "C",
+           (unsigned long)(soft / BENCH_SAMPLES), (unsigned long)(soft % BENCH_SAMPLES * 100 / BENCH_SAMPLES),
+           (unsigned long)(interp / BENCH_SAMPLES), (unsigned long)(interp % BENCH_SAMPLES * 100 / BENCH_SAMPLES),
+           (unsigned long)mismatches);
+}
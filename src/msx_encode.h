@@ -0,0 +1,76 @@
+#ifndef _MSX_ENCODE_H_
+#define _MSX_ENCODE_H_
+
+#include <stdint.h>
+
+#include "hardware/interp.h"
+#include "msx_protocol.h"
+
+// -----------------------------------------------------------------------------
+// Snapshot für den Sampler: ausstehende Bewegung auf +-limit (höchstens
+// MSX_READ_LIMIT) begrenzen und in die Nibble-Reihenfolge des Protokolls
+// bringen
+//
+// Mit ROLAND_MSX_INTERP=1 übernehmen die Interpolatoren des aufrufenden Cores
+// beides: interp1 Lane 0 begrenzt vorzeichenbehaftet (Clamp-Modus, den nur
+// interp1 hat), interp0 tauscht die Nibbles beider Achsen und setzt sie im
+// vollen Ergebnis zusammen. Der Nibble-Tausch nutzt, dass (v * 0x101) >> 4 in den unteren
+// 8 Bit die vertauschten Nibbles von v enthält.
+//
+// Die Interpolatoren sind je Core vorhanden; msx_encode_init() muss auf dem
+// Core laufen, der kodiert (der Ausgabe-Core). Nichts anderes darf sie dort
+// benutzen, da der PIO-IRQ sie ohne Sichern verwendet.
+// Host-Build: standardmäßig der C-Pfad (host/include/hardware/interp.h
+// bildet die Interpolatoren nur für den Vergleich im Benchmark nach).
+// -----------------------------------------------------------------------------
+
+#ifndef ROLAND_MSX_INTERP
+#ifdef ROLAND_HOST_BUILD
+#define ROLAND_MSX_INTERP 0
+#else
+#define ROLAND_MSX_INTERP 1
+#endif
+#endif
+
+// Größter Wert je Lesevorgang, von msx_encode_init() gesetzt
+extern int32_t msx_encode_limit;
+
+void msx_encode_init(int32_t limit);
+
+// Reiner C-Pfad (Fallback und Referenz)
+static inline uint32_t msx_encode_soft(int32_t x, int32_t y, int32_t limit)
+{
+    if (x >  limit) x =  limit;
+    if (x < -limit) x = -limit;
+    if (y >  limit) y =  limit;
+    if (y < -limit) y = -limit;
+    return msx_pack_snapshot(x, y);
+}
+
+// Über die Interpolatoren (nach msx_encode_init() auf diesem Core)
+static inline uint32_t msx_encode_interp(int32_t x, int32_t y)
+{
+    interp_set_accumulator(interp1, 0, (uint32_t)x);
+    uint32_t const cx = interp_peek_lane_result(interp1, 0);
+    interp_set_accumulator(interp1, 0, (uint32_t)y);
+    uint32_t const cy = interp_peek_lane_result(interp1, 0);
+
+    interp_set_accumulator(interp0, 0, (cx & 0xFF) * 0x101u);
+    interp_set_accumulator(interp0, 1, (cy & 0xFF) * 0x10100u);
+    return interp_peek_full_result(interp0);
+}
+
+static inline uint32_t msx_encode_snapshot(int32_t x, int32_t y)
+{
+#if ROLAND_MSX_INTERP
+    return msx_encode_interp(x, y);
+#else
+    return msx_encode_soft(x, y, msx_encode_limit);
+#endif
+}
+
+// Beide Pfade gegeneinander prüfen und Kosten je Snapshot ausgeben
+// (CYCLES_UNIT); konfiguriert die Interpolatoren des aufrufenden Cores
+void msx_encode_bench(void);
+
+#endif
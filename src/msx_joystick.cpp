@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "motion_accumulator.h"
+#include "msx_joystick.h"
+#include "pin_masks.h"
+#include "pins.h"
+
+// Pulsbreite; MSX-Programme fragen meist einmal je Bild (16,7 ms) ab und
+// sehen die Richtung dann mit der Wahrscheinlichkeit der Pulsdichte
+#ifndef ROLAND_JOY_TICK_US
+#define ROLAND_JOY_TICK_US 2000
+#endif
+
+// Counts je Puls: bestimmt, ab welcher Geschwindigkeit Dauerbetätigung erreicht ist
+#ifndef ROLAND_JOY_COUNTS_PER_PULSE
+#define ROLAND_JOY_COUNTS_PER_PULSE 4
+#endif
+
+// Je Takt wird 1/2^SHIFT des Rückstaus entnommen (mindestens ein Count);
+// glättet die Bewegung zwischen zwei Reports
+#ifndef ROLAND_JOY_DRAIN_SHIFT
+#define ROLAND_JOY_DRAIN_SHIFT 2
+#endif
+
+#ifndef ROLAND_JOY_MAX_PENDING
+#define ROLAND_JOY_MAX_PENDING 256
+#endif
+
+// Nibble-Bits = D0..D3 in Joystick-Belegung; die Trigger schreibt msx_buttons
+#define JOY_UP     0x01
+#define JOY_DOWN   0x02
+#define JOY_LEFT   0x04
+#define JOY_RIGHT  0x08
+
+static MotionAccumulator motion;   // USB-Richtung; Producer: Reports, Consumer: Timer
+static repeating_timer_t timer;
+
+// Nur im Timer: entnommene, noch nicht als Puls ausgegebene Counts
+static int32_t residual_x;
+static int32_t residual_y;
+
+static msx_joystick_stats_t stats;
+
+static int32_t drain(int32_t pending)
+{
+    if (!pending) return 0;
+    int32_t const part = pending / (1 << ROLAND_JOY_DRAIN_SHIFT);
+    if (part) return part;
+    return pending > 0 ? 1 : -1;
+}
+
+// Rückstau oberhalb ROLAND_JOY_MAX_PENDING
+static int32_t excess(int32_t pending)
+{
+    if (pending >  ROLAND_JOY_MAX_PENDING) return pending - ROLAND_JOY_MAX_PENDING;
+    if (pending < -ROLAND_JOY_MAX_PENDING) return pending + ROLAND_JOY_MAX_PENDING;
+    return 0;
+}
+
+static uint32_t magnitude(int32_t v)
+{
+    return (uint32_t)(v < 0 ? -v : v);
+}
+
+// Sigma-Delta: ein Puls je volle ROLAND_JOY_COUNTS_PER_PULSE Counts;
+// liefert +1/-1 für einen Puls in diese Richtung, sonst 0
+static int32_t pulse(int32_t* residual)
+{
+    if (*residual >= ROLAND_JOY_COUNTS_PER_PULSE) {
+        *residual -= ROLAND_JOY_COUNTS_PER_PULSE;
+        return 1;
+    }
+    if (*residual <= -ROLAND_JOY_COUNTS_PER_PULSE) {
+        *residual += ROLAND_JOY_COUNTS_PER_PULSE;
+        return -1;
+    }
+    return 0;
+}
+
+static bool joystick_tick(repeating_timer_t* rt)
+{
+    (void)rt;
+    stats.ticks++;
+
+    int32_t px = motion.pending_x();
+    int32_t py = motion.pending_y();
+
+    // Mehr, als Dauerbetätigung abbauen kann: verbuchen, ohne es auszugeben
+    int32_t const ex = excess(px + residual_x);
+    int32_t const ey = excess(py + residual_y);
+    if (ex || ey) {
+        motion.consume(ex, ey);
+        stats.dropped += magnitude(ex) + magnitude(ey);
+        px -= ex;
+        py -= ey;
+    }
+
+    int32_t const dx = drain(px);
+    int32_t const dy = drain(py);
+    motion.consume(dx, dy);
+    residual_x += dx;
+    residual_y += dy;
+
+    uint8_t held = 0;
+    int32_t const sx = pulse(&residual_x);
+    int32_t const sy = pulse(&residual_y);
+    if (sx > 0) held |= JOY_RIGHT;
+    if (sx < 0) held |= JOY_LEFT;
+    if (sy > 0) held |= JOY_DOWN;
+    if (sy < 0) held |= JOY_UP;
+    if (sx) stats.pulses_x++;
+    if (sy) stats.pulses_y++;
+
+    gpio_put_masked(MSX_DATA_MASK, msx_nibble_levels((uint8_t)~held));   // aktiv low, ein Zugriff
+    return true;
+}
+
+void msx_joystick_init(void)
+{
+    for (uint i = 0; i < 4; i++) {
+        gpio_init(msx_data_pin[i]);
+        gpio_set_dir(msx_data_pin[i], GPIO_OUT);
+    }
+    gpio_put_masked(MSX_DATA_MASK, msx_nibble_levels(0x0F));
+
+    residual_x = 0;
+    residual_y = 0;
+
+    // Negativer Abstand: Takt gemessen ab Beginn des Callbacks
+    add_repeating_timer_us(-ROLAND_JOY_TICK_US, joystick_tick, nullptr, &timer);
+}
+
+void msx_joystick_deinit(void)
+{
+    cancel_repeating_timer(&timer);
+    for (uint i = 0; i < 4; i++) {
+        gpio_init(msx_data_pin[i]);
+    }
+}
+
+void msx_joystick_add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+{
+    (void)arrival_us;
+    if (!dx && !dy) return;
+    motion.add(dx, dy);
+}
+
+msx_joystick_stats_t msx_joystick_get_stats(void)
+{
+    return stats;
+}
+
+void msx_joystick_print_stats(void)
+{
+    printf("Joystick: ticks=%lu, pulses x/y=%lu/%lu, dropped=%lu counts\n",
+           (unsigned long)stats.ticks, (unsigned long)stats.pulses_x,
+           (unsigned long)stats.pulses_y, (unsigned long)stats.dropped);
+}
@@ -0,0 +1,39 @@
+#ifndef _MSX_JOYSTICK_H_
+#define _MSX_JOYSTICK_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// MSX-Joystick-Emulation auf denselben Pins wie der Mausausgang
+//
+// D0..D3 sind hier Hoch/Runter/Links/Rechts (aktiv low); Trigger A/B kommen
+// wie bei der Maus aus msx_buttons. Bewegung landet wie bei der Maus in einem MotionAccumulator; ein
+// Timer (ROLAND_JOY_TICK_US) entnimmt je Takt einen Teil des Rückstaus und
+// setzt ihn per Sigma-Delta in Pulse um: je ROLAND_JOY_COUNTS_PER_PULSE
+// Counts ein Takt mit gehaltener Richtung. Die Pulsdichte folgt so der
+// Geschwindigkeit, von vereinzelten Pulsen bis zur Dauerbetätigung.
+//
+// Die Richtungs-Pins werden nur im Timer geschrieben, mit einem maskierten
+// Zugriff je Takt; Reports ändern lediglich den Akkumulator. Was über
+// ROLAND_JOY_MAX_PENDING Counts hinaus aussteht (Dauerbetätigung reicht
+// nicht), wird verworfen, damit der Joystick nicht nachläuft.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t ticks;       // Timer-Takte
+    uint32_t pulses_x;    // Takte mit gehaltenem Links/Rechts
+    uint32_t pulses_y;    // Takte mit gehaltenem Hoch/Runter
+    uint32_t dropped;     // verworfene Counts (über ROLAND_JOY_MAX_PENDING)
+} msx_joystick_stats_t;
+
+// Auf dem Core aufrufen, der auch msx_joystick_add_motion() aufruft
+void msx_joystick_init(void);
+void msx_joystick_deinit(void);
+
+// Bewegung aus einem HID-Report (USB-Richtung: +x rechts, +y unten)
+void msx_joystick_add_motion(int32_t dx, int32_t dy, uint32_t arrival_us);
+
+msx_joystick_stats_t msx_joystick_get_stats(void);
+void msx_joystick_print_stats(void);
+
+#endif
@@ -0,0 +1,180 @@
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+
+#include "latency.h"
+#include "motion_accumulator.h"
+#include "msx_encode.h"
+#include "msx_mouse.pio.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+#include "pin_masks.h"
+#include "pins.h"
+
+// "out pins, 4" schreibt D0..D3 in einem Takt, braucht sie aber aufeinanderfolgend
+static_assert(PIN_MSX_D1 == PIN_MSX_D0 + 1 && PIN_MSX_D2 == PIN_MSX_D0 + 2 && PIN_MSX_D3 == PIN_MSX_D0 + 3,
+              "PIO-Ausgang braucht aufeinanderfolgende Datenpins");
+
+static PIO  pio = pio0;
+static uint sm;
+static uint program_offset;
+
+// Bewegung in MSX-Richtung (+x links, +y oben)
+static MotionAccumulator motion;
+
+static volatile uint32_t read_count;
+static volatile uint32_t carry_count;
+static volatile uint32_t resync_count;
+
+// Strobe-Watchdog: Stand der State-Machine beim letzten Alarm
+static int                watchdog_alarm = -1;
+static msx_strobe_watch_t watch;
+
+static inline void push_snapshot(void)
+{
+    latency_snapshot();
+    pio_sm_put(pio, sm, msx_encode_snapshot(motion.pending_x(), motion.pending_y()));
+}
+
+// -----------------------------------------------------------------------------
+// PIO-IRQ: Lesezyklus abgeschlossen oder neue Bewegung (irq_set_pending)
+//
+// Nur dieser Handler greift auf die FIFOs zu; die USB-Seite addiert lediglich
+// in den Akkumulator und stößt ihn an.
+// -----------------------------------------------------------------------------
+static void __isr msx_output_irq(void)
+{
+    if (pio_interrupt_get(pio, sm)) {
+        bool moved = false;
+        while (!pio_sm_is_rx_fifo_empty(pio, sm)) {
+            uint32_t sent = pio_sm_get(pio, sm);
+            motion.consume(msx_snapshot_x(sent), msx_snapshot_y(sent));
+            moved |= (sent & 0xFFFF) != 0;
+            read_count++;
+        }
+        bool carry = motion.pending_x() != 0 || motion.pending_y() != 0;
+        if (carry) carry_count++;
+        if (moved) latency_delivered(time_us_32(), carry);
+
+        // Veraltete Snapshots verwerfen, sonst würde verbuchte Bewegung doppelt gesendet
+        pio_sm_clear_fifos(pio, sm);
+        push_snapshot();
+
+        pio_interrupt_clear(pio, sm);   // State-Machine läuft weiter
+        return;
+    }
+
+    // Neue Bewegung: frischeren Snapshot nachschieben. Ist der FIFO voll,
+    // läuft gerade ein Lesezyklus; danach wird ohnehin neu befüllt.
+    if (!pio_sm_is_tx_fifo_full(pio, sm)) push_snapshot();
+}
+
+// -----------------------------------------------------------------------------
+// Strobe-Watchdog (Hardware-Alarm, alle ROLAND_MSX_STROBE_TIMEOUT_US)
+//
+// Steht die State-Machine bei zwei Alarmen nacheinander an derselben Stelle
+// zwischen cycle und done, ohne dass dazwischen ein Lesezyklus fertig wurde,
+// gab es im ganzen Intervall keine Strobe-Flanke (msx_strobe_watch, auch im
+// Host-Modell geprüft). Der Alarm läuft fest im Takt, nicht ab der letzten
+// Flanke; ein Abbruch wird daher nach T bis 2T erkannt. Der Alarm läuft auf
+// dem Core des PIO-IRQ mit gleicher Priorität, unterbricht den Handler also
+// nicht.
+// -----------------------------------------------------------------------------
+static void resync(void)
+{
+    // Nichts verbuchen: der Sampler hat den Snapshot nicht vollständig gelesen
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(program_offset + msx_mouse_offset_idle));
+    push_snapshot();
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+static void strobe_watchdog(uint alarm_num)
+{
+    uint const pc       = pio_sm_get_pc(pio, sm);
+    bool const in_cycle = pc >= program_offset + msx_mouse_offset_cycle &&
+                          pc <  program_offset + msx_mouse_offset_done;
+    bool const partial  = pc >= program_offset + msx_mouse_offset_partial;
+
+    msx_watch_action_t const action = msx_strobe_watch(&watch, in_cycle, partial, pc, read_count);
+    if (action != MSX_WATCH_OK) {
+        // Nur X high ausgegeben und Strobe weiter high: Sampler parkt den
+        // Strobe, kein Abbruch. Trotzdem neu beginnen, damit der Snapshot frisch ist.
+        if (action == MSX_WATCH_RESYNC_ABORTED) resync_count++;
+        resync();
+        watch.pos = pio_sm_get_pc(pio, sm);
+    }
+
+    hardware_alarm_set_target(alarm_num, make_timeout_time_us(ROLAND_MSX_STROBE_TIMEOUT_US));
+}
+
+void msx_output_init(int32_t read_limit)
+{
+    msx_encode_init(read_limit);   // Interpolatoren dieses Cores für den IRQ-Handler
+
+    gpio_init(PIN_MSX_STROBE);
+    gpio_set_dir(PIN_MSX_STROBE, GPIO_IN);
+
+    sm = pio_claim_unused_sm(pio, true);
+    program_offset = pio_add_program(pio, &msx_mouse_program);
+
+    pio_set_irq0_source_enabled(pio, (pio_interrupt_source)(pis_interrupt0 + sm), true);
+    irq_set_exclusive_handler(PIO0_IRQ_0, msx_output_irq);
+    irq_set_enabled(PIO0_IRQ_0, true);
+
+    msx_mouse_program_init(pio, sm, program_offset, PIN_MSX_DATA_BASE, PIN_MSX_STROBE);
+
+    // Alarm-IRQ auf diesem Core, wie der PIO-IRQ
+    watch.pos      = pio_sm_get_pc(pio, sm);
+    watch.reads    = read_count;
+    watchdog_alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback((uint)watchdog_alarm, strobe_watchdog);
+    hardware_alarm_set_target((uint)watchdog_alarm, make_timeout_time_us(ROLAND_MSX_STROBE_TIMEOUT_US));
+}
+
+void msx_output_deinit(void)
+{
+    hardware_alarm_set_callback((uint)watchdog_alarm, nullptr);   // bricht auch den Alarm ab
+    hardware_alarm_unclaim((uint)watchdog_alarm);
+    watchdog_alarm = -1;
+
+    irq_set_enabled(PIO0_IRQ_0, false);
+    pio_set_irq0_source_enabled(pio, (pio_interrupt_source)(pis_interrupt0 + sm), false);
+    irq_remove_handler(PIO0_IRQ_0, msx_output_irq);
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_remove_program(pio, &msx_mouse_program, program_offset);
+    pio_sm_unclaim(pio, sm);
+
+    for (uint i = 0; i < 4; i++) {
+        gpio_init(PIN_MSX_DATA_BASE + i);   // zurück an SIO, Eingang
+    }
+}
+
+void msx_output_add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+{
+    if (!dx && !dy) return;
+
+    // MSX-Maus meldet die Gegenrichtung: positiv = links bzw. oben
+    motion.add(-dx, -dy);
+    latency_motion_added(arrival_us);
+    irq_set_pending(PIO0_IRQ_0);
+}
+
+uint32_t msx_output_read_count(void)
+{
+    return read_count;
+}
+
+uint32_t msx_output_carry_count(void)
+{
+    return carry_count;
+}
+
+uint32_t msx_output_resync_count(void)
+{
+    return resync_count;
+}
@@ -0,0 +1,37 @@
+#ifndef _MSX_OUTPUT_H_
+#define _MSX_OUTPUT_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// MSX-Mausausgang: PIO-State-Machine beantwortet den Strobe des Samplers
+// (siehe msx_mouse.pio). Die CPU hält nur den Snapshot im TX-FIFO aktuell
+// und verbucht nach jedem vollständigen Lesezyklus die ausgegebenen Werte
+// im MotionAccumulator; was über +-127 hinausgeht, folgt im nächsten Lesen.
+// Ein Hardware-Alarm prüft, ob ein Lesezyklus hängen geblieben ist.
+// -----------------------------------------------------------------------------
+
+// read_limit: größter Wert je Achse und Lesevorgang (höchstens MSX_READ_LIMIT)
+void msx_output_init(int32_t read_limit);
+
+// State-Machine, IRQ und Pins freigeben (Umschalten des Ausgangsprotokolls)
+void msx_output_deinit(void);
+
+// Bewegung aus einem HID-Report (USB-Richtung: +x rechts, +y unten),
+// arrival_us = Eingang des Reports (für die Latenzmessung).
+// Wait-free: addiert in den Akkumulator und stößt den PIO-IRQ an. Muss auf
+// dem Core laufen, der msx_output_init() aufgerufen hat.
+void msx_output_add_motion(int32_t dx, int32_t dy, uint32_t arrival_us);
+
+// Anzahl vollständig gelesener Snapshots
+uint32_t msx_output_read_count(void);
+
+// Lesevorgänge, nach denen wegen der +-127-Grenze noch Bewegung ausstand
+uint32_t msx_output_carry_count(void);
+
+// Abgebrochene Lesezyklen: der Strobe stand nach mindestens einer Flanke
+// länger als ROLAND_MSX_STROBE_TIMEOUT_US still. Der Zyklus wird nicht
+// verbucht, das nächste Lesen beginnt wieder mit X high.
+uint32_t msx_output_resync_count(void);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _MSX_PROTOCOL_H_
+#define _MSX_PROTOCOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// MSX-Maus-Snapshot: 4 Nibbles in Lesereihenfolge, das erste unten
+//   Bits 0-3 X high, 4-7 X low, 8-11 Y high, 12-15 Y low
+// Gemeinsam für PIO-Ausgang (msx_mouse.pio) und Host-Modell.
+// -----------------------------------------------------------------------------
+
+// Größter Wert pro Lesevorgang; -128 bleibt ungenutzt, damit beide
+// Richtungen symmetrisch sind
+#define MSX_READ_LIMIT 127
+
+#define MSX_NIBBLES_PER_READ 4
+
+// Bleibt der Strobe mitten im Lesezyklus ruhig, hat der Sampler
+// abgebrochen: Nibble-Zähler zurück auf X high, neuer Snapshot. Ein
+// vollständiges Lesen dauert unter 100 us, Abfragen kommen einmal je Bild.
+// Der Watchdog prüft alle ROLAND_MSX_STROBE_TIMEOUT_US (T) und braucht zwei
+// Prüfungen mit demselben Stand: erkannt wird also nach T bis 2T Ruhe,
+// sicher erst ab 2T.
+#ifndef ROLAND_MSX_STROBE_TIMEOUT_US
+#define ROLAND_MSX_STROBE_TIMEOUT_US 1000
+#endif
+
+// Stand des Lesezyklus bei der letzten Prüfung
+typedef struct {
+    uint32_t pos;     // Stelle im Zyklus: PIO-Programmzähler bzw. Nibble-Index im Modell
+    uint32_t reads;   // fertige Lesezyklen
+} msx_strobe_watch_t;
+
+typedef enum {
+    MSX_WATCH_OK = 0,
+    MSX_WATCH_RESYNC,           // Zyklus steht, aber noch kein Nibble gelesen (Strobe geparkt)
+    MSX_WATCH_RESYNC_ABORTED,   // Zyklus mittendrin abgebrochen, zählt als Resync
+} msx_watch_action_t;
+
+// Entscheidung je Prüfung, gemeinsam für msx_output.cpp und das Host-Modell:
+// ein Zyklus, der seit der letzten Prüfung weder weiterkam noch fertig wurde,
+// hatte im ganzen Intervall keine Strobe-Flanke. partial = mindestens ein
+// Nibble nach X high ausgegeben.
+static inline msx_watch_action_t msx_strobe_watch(msx_strobe_watch_t* w, bool in_cycle, bool partial,
+                                                  uint32_t pos, uint32_t reads)
+{
+    bool const stuck = in_cycle && pos == w->pos && reads == w->reads;
+    w->pos   = pos;
+    w->reads = reads;
+    if (!stuck) return MSX_WATCH_OK;
+    return partial ? MSX_WATCH_RESYNC_ABORTED : MSX_WATCH_RESYNC;
+}
+
+static inline uint8_t msx_swap_nibbles(uint8_t v)
+{
+    return (uint8_t)((v << 4) | (v >> 4));
+}
+
+static inline uint32_t msx_pack_snapshot(int32_t x, int32_t y)
+{
+    return msx_swap_nibbles((uint8_t)x) | ((uint32_t)msx_swap_nibbles((uint8_t)y) << 8);
+}
+
+static inline int8_t msx_snapshot_x(uint32_t snapshot)
+{
+    return (int8_t)msx_swap_nibbles((uint8_t)snapshot);
+}
+
+static inline int8_t msx_snapshot_y(uint32_t snapshot)
+{
+    return (int8_t)msx_swap_nibbles((uint8_t)(snapshot >> 8));
+}
+
+// Nibble Nummer index (0..3) eines Snapshots
+static inline uint8_t msx_snapshot_nibble(uint32_t snapshot, uint8_t index)
+{
+    return (uint8_t)((snapshot >> (4 * index)) & 0x0F);
+}
+
+#endif
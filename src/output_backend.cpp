@@ -0,0 +1,17 @@
+#include "output_backend.h"
+
+output_backend_ops_t const output_backend_table[OUTPUT_BACKEND_COUNT] = {
+    output_backend_ops_of<output_backend_by_id<OUTPUT_MSX_MOUSE>::type>(),
+    output_backend_ops_of<output_backend_by_id<OUTPUT_MU1_PACED>::type>(),
+    output_backend_ops_of<output_backend_by_id<OUTPUT_MSX_JOYSTICK>::type>(),
+};
+
+output_backend_ops_t const* RuntimeBackend::ops = &output_backend_table[ROLAND_OUTPUT_BACKEND];
+
+void RuntimeBackend::select(output_backend_id_t id)
+{
+    if (ops == &output_backend_table[id]) return;
+    ops->deinit();
+    ops = &output_backend_table[id];
+    ops->init();
+}
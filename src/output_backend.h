@@ -0,0 +1,130 @@
+#ifndef _OUTPUT_BACKEND_H_
+#define _OUTPUT_BACKEND_H_
+
+#include <stdint.h>
+
+#include "msx_joystick.h"
+#include "msx_output.h"
+#include "msx_protocol.h"
+
+// -----------------------------------------------------------------------------
+// Ausgangsprotokolle als Policy-Klassen
+//
+// Jede Klasse bietet dieselben statischen Funktionen (name, init, deinit,
+// add_motion). output_task ruft sie über OutputBackend auf:
+//
+//   Standard                ROLAND_OUTPUT_BACKEND wählt die Klasse zur
+//                           Compile-Zeit; Aufrufe sind direkt und inline
+//   ROLAND_OUTPUT_RUNTIME=1 RuntimeBackend ruft über eine Funktionstabelle,
+//                           umschaltbar auf der Konsole (Vergleichsbuild)
+//
+// msx-mouse und mu1-paced sind dasselbe Mausprotokoll und unterscheiden sich
+// nur im größten Wert je Lesevorgang (127 bzw. 32); am Timing ändert sich
+// nichts, das bestimmt die PIO-State-Machine über die Strobe-Flanken.
+// Die Trigger-Pins gehören keinem Protokoll (msx_buttons.h).
+// -----------------------------------------------------------------------------
+
+typedef enum {
+    OUTPUT_MSX_MOUSE = 0,
+    OUTPUT_MU1_PACED,
+    OUTPUT_MSX_JOYSTICK,
+    OUTPUT_BACKEND_COUNT
+} output_backend_id_t;
+
+#ifndef ROLAND_OUTPUT_BACKEND
+#define ROLAND_OUTPUT_BACKEND OUTPUT_MSX_MOUSE
+#endif
+
+#ifndef ROLAND_OUTPUT_RUNTIME
+#define ROLAND_OUTPUT_RUNTIME 0
+#endif
+
+// Je Lesevorgang höchstens 32 Counts: der Cursor holt große Sprünge über
+// mehrere Lesezyklen gleichmäßig auf
+#ifndef ROLAND_MU1_PACED_LIMIT
+#define ROLAND_MU1_PACED_LIMIT 32
+#endif
+
+// --- Lese-Grenzen des Mausprotokolls -------------------------------------------
+
+struct FullReadLimit {
+    static constexpr char const* name() { return "msx-mouse"; }
+    static constexpr int32_t read_limit = MSX_READ_LIMIT;
+};
+
+struct PacedReadLimit {
+    static constexpr char const* name() { return "mu1-paced"; }
+    static constexpr int32_t read_limit = ROLAND_MU1_PACED_LIMIT;
+};
+
+// --- Policy-Klassen --------------------------------------------------------------
+
+template <class Limit>
+struct MsxMouseBackend {
+    static constexpr char const* name() { return Limit::name(); }
+    static void init()   { msx_output_init(Limit::read_limit); }
+    static void deinit() { msx_output_deinit(); }
+
+    static void add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+    {
+        msx_output_add_motion(dx, dy, arrival_us);
+    }
+};
+
+struct MsxJoystickBackend {
+    static constexpr char const* name() { return "msx-joystick"; }
+    static void init()   { msx_joystick_init(); }
+    static void deinit() { msx_joystick_deinit(); }
+
+    static void add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+    {
+        msx_joystick_add_motion(dx, dy, arrival_us);
+    }
+};
+
+template <int Id> struct output_backend_by_id;
+template <> struct output_backend_by_id<OUTPUT_MSX_MOUSE>    { using type = MsxMouseBackend<FullReadLimit>; };
+template <> struct output_backend_by_id<OUTPUT_MU1_PACED>    { using type = MsxMouseBackend<PacedReadLimit>; };
+template <> struct output_backend_by_id<OUTPUT_MSX_JOYSTICK> { using type = MsxJoystickBackend; };
+
+// --- Laufzeit-Auswahl über Funktionstabelle ------------------------------------
+
+typedef struct {
+    char const* name;
+    void (*init)(void);
+    void (*deinit)(void);
+    void (*add_motion)(int32_t dx, int32_t dy, uint32_t arrival_us);
+} output_backend_ops_t;
+
+template <class B>
+constexpr output_backend_ops_t output_backend_ops_of()
+{
+    return { B::name(), B::init, B::deinit, B::add_motion };
+}
+
+// Eintrag je output_backend_id_t
+extern output_backend_ops_t const output_backend_table[OUTPUT_BACKEND_COUNT];
+
+struct RuntimeBackend {
+    static output_backend_ops_t const* ops;
+
+    static char const* name() { return ops->name; }
+    static void init()   { ops->init(); }
+    static void deinit() { ops->deinit(); }
+
+    static void add_motion(int32_t dx, int32_t dy, uint32_t arrival_us)
+    {
+        ops->add_motion(dx, dy, arrival_us);
+    }
+
+    // Aktives Protokoll abbauen und das neue starten (auf dem Ausgabe-Core)
+    static void select(output_backend_id_t id);
+};
+
+#if ROLAND_OUTPUT_RUNTIME
+using OutputBackend = RuntimeBackend;
+#else
+using OutputBackend = output_backend_by_id<ROLAND_OUTPUT_BACKEND>::type;
+#endif
+
+#endif
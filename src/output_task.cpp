@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+#include "msx_buttons.h"
+#include "msx_joystick.h"
+#include "msx_output.h"
+#include "output_backend.h"
+#include "output_task.h"
+#include "spsc_queue.h"
+
+#ifndef ROLAND_MULTICORE
+#define ROLAND_MULTICORE 0
+#endif
+
+#ifndef ROLAND_EVENT_QUEUE_SIZE
+#define ROLAND_EVENT_QUEUE_SIZE 64
+#endif
+
+static output_task_stats_t stats;
+
+// Zuletzt gewähltes Protokoll (output_backend_id_t)
+static uint8_t backend_id = ROLAND_OUTPUT_BACKEND;
+
+#if ROLAND_OUTPUT_RUNTIME
+// Umschaltwunsch von der Konsole; der Ausgabe-Core übernimmt ihn
+static volatile int32_t select_request = -1;
+
+static void apply_select_request(void)
+{
+    int32_t const id = select_request;
+    if (id < 0) return;
+    select_request = -1;
+    RuntimeBackend::select((output_backend_id_t)id);
+}
+#else
+static inline void apply_select_request(void) {}
+#endif
+
+#if ROLAND_MULTICORE
+
+typedef struct {
+    int32_t  dx;
+    int32_t  dy;
+    uint32_t arrival_us;
+} motion_event_t;
+
+static SpscQueue<motion_event_t, ROLAND_EVENT_QUEUE_SIZE> queue;
+
+// Core0: Bewegung, die wegen voller Queue noch nicht übergeben wurde
+static int32_t  residual_dx;
+static int32_t  residual_dy;
+static uint32_t residual_arrival_us;
+
+// Queue voll: Bewegung nicht verwerfen, sondern als Rest behalten
+static bool push_residual(int32_t dx, int32_t dy)
+{
+    motion_event_t ev = { dx, dy, residual_arrival_us };
+    if (queue.push(ev)) {
+        residual_dx = 0;
+        residual_dy = 0;
+        __sev();
+        return true;
+    }
+    residual_dx = dx;
+    residual_dy = dy;
+    return false;
+}
+
+// Core1 zählt monoton; Core0 rechnet Differenzen zur letzten Rücksetzung
+static volatile uint32_t core1_busy_total_us;
+static volatile uint32_t core1_idle_total_us;
+static uint32_t core1_busy_base_us;
+static uint32_t core1_idle_base_us;
+
+// -----------------------------------------------------------------------------
+// Core1: Ereignisse aus der Queue an den MSX-Ausgang weitergeben
+// -----------------------------------------------------------------------------
+static void core1_main(void)
+{
+    // PIO-IRQ bzw. Timer auf Core1 registrieren, damit Core0 sie nie verzögert
+    OutputBackend::init();
+    flash_safe_execute_core_init();   // Core0 hält Core1 an, während er Flash schreibt
+
+    uint32_t t = time_us_32();
+    while (true) {
+        apply_select_request();
+        motion_event_t ev;
+        while (queue.pop(ev)) {
+            OutputBackend::add_motion(ev.dx, ev.dy, ev.arrival_us);
+        }
+
+        uint32_t idle_start = time_us_32();
+        core1_busy_total_us += idle_start - t;
+        __wfe();   // Core0 weckt per __sev(), PIO-IRQ weckt ebenfalls
+        t = time_us_32();
+        core1_idle_total_us += t - idle_start;
+    }
+}
+
+#endif
+
+void output_task_start(void)
+{
+    msx_buttons_init();   // Report-Pfad, Core0
+
+#if ROLAND_MULTICORE
+    stats.queue_capacity = queue.capacity();
+    multicore_launch_core1(core1_main);
+#else
+    OutputBackend::init();
+#endif
+}
+
+bool output_task_select(uint8_t backend)
+{
+#if ROLAND_OUTPUT_RUNTIME
+    if (backend >= OUTPUT_BACKEND_COUNT) return false;
+    backend_id     = backend;
+    select_request = backend;
+#if ROLAND_MULTICORE
+    __sev();
+#else
+    apply_select_request();
+#endif
+    return true;
+#else
+    (void)backend;
+    return false;
+#endif
+}
+
+uint8_t output_task_backend(void)
+{
+    return backend_id;
+}
+
+char const* output_task_backend_name(void)
+{
+    return OutputBackend::name();
+}
+
+void output_task_post(int32_t dx, int32_t dy, uint8_t buttons, uint32_t arrival_us)
+{
+    stats.posted++;
+
+    // Tasten direkt an die Pins, vor jeder Queue
+    msx_buttons_write(buttons, arrival_us);
+
+#if ROLAND_MULTICORE
+    if (!dx && !dy && !residual_dx && !residual_dy) return;
+
+    // Gefaltete Ereignisse behalten den Eingang des ältesten Reports
+    if (!residual_dx && !residual_dy) residual_arrival_us = arrival_us;
+    if (!push_residual(residual_dx + dx, residual_dy + dy)) stats.coalesced++;
+#else
+    OutputBackend::add_motion(dx, dy, arrival_us);
+#endif
+}
+
+void output_task_service(void)
+{
+#if ROLAND_MULTICORE
+    // Rest aus voller Queue nachschieben, auch wenn die Maus inzwischen steht
+    if (residual_dx || residual_dy) push_residual(residual_dx, residual_dy);
+#endif
+}
+
+output_task_stats_t output_task_get_stats(void)
+{
+    output_task_stats_t s = stats;
+#if ROLAND_MULTICORE
+    s.queue_high_water = queue.high_water();
+    s.core1_busy_us    = core1_busy_total_us - core1_busy_base_us;
+    s.core1_idle_us    = core1_idle_total_us - core1_idle_base_us;
+#endif
+    return s;
+}
+
+void output_task_reset_stats(void)
+{
+    stats.posted    = 0;
+    stats.coalesced = 0;
+    msx_buttons_reset_stats();
+#if ROLAND_MULTICORE
+    queue.reset_high_water();
+    core1_busy_base_us = core1_busy_total_us;
+    core1_idle_base_us = core1_idle_total_us;
+#endif
+}
+
+void output_task_print_stats(void)
+{
+#if ROLAND_MULTICORE
+    output_task_stats_t s = output_task_get_stats();
+    uint32_t total    = s.core1_busy_us + s.core1_idle_us;
+    uint32_t load_pct = total ? (uint32_t)((uint64_t)s.core1_busy_us * 100u / total) : 0;
+
+    printf("Core1: load=%lu%%, events=%lu, coalesced=%lu, queue hwm=%lu/%lu\n",
+           (unsigned long)load_pct, (unsigned long)s.posted, (unsigned long)s.coalesced,
+           (unsigned long)s.queue_high_water, (unsigned long)s.queue_capacity);
+#else
+    printf("Output: single core, events=%lu\n", (unsigned long)stats.posted);
+#endif
+    printf("Backend: %s (%s)\n", OutputBackend::name(), ROLAND_OUTPUT_RUNTIME ? "runtime" : "compile-time");
+    printf("MSX: reads=%lu, carried=%lu, resyncs=%lu\n",
+           (unsigned long)msx_output_read_count(), (unsigned long)msx_output_carry_count(),
+           (unsigned long)msx_output_resync_count());
+    msx_joystick_print_stats();
+    msx_buttons_print_stats();
+}
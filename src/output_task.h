@@ -0,0 +1,44 @@
+#ifndef _OUTPUT_TASK_H_
+#define _OUTPUT_TASK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Ausgabeseite (Sampler-Protokoll)
+//
+// Mit ROLAND_MULTICORE=1 läuft sie auf Core1; Bewegungs- und Tastenereignisse
+// kommen über eine lock-freie SPSC-Queue von Core0 (tuh_task + HID-Callbacks).
+// Ohne Multicore werden die Ereignisse direkt auf Core0 verarbeitet. Tasten
+// schreibt output_task_post() in beiden Fällen sofort (msx_buttons.h).
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t posted;          // von Core0 gemeldete Ereignisse
+    uint32_t coalesced;       // Queue voll: Ereignis in das nächste gefaltet
+    uint32_t queue_high_water;
+    uint32_t queue_capacity;
+    uint32_t core1_busy_us;   // Core1: Zeit außerhalb von WFE
+    uint32_t core1_idle_us;
+} output_task_stats_t;
+
+void output_task_start(void);
+
+// Aus dem HID-Report-Callback (Core0); arrival_us = Eingang des Reports
+void output_task_post(int32_t dx, int32_t dy, uint8_t buttons, uint32_t arrival_us);
+
+// Hauptschleife (Core0): Bewegung, die bei voller Queue liegen blieb, erneut
+// übergeben; ohne Multicore leer
+void output_task_service(void);
+
+// Ausgangsprotokoll wechseln (output_backend_id_t); nur mit
+// ROLAND_OUTPUT_RUNTIME=1, sonst false
+bool output_task_select(uint8_t backend);
+uint8_t output_task_backend(void);
+char const* output_task_backend_name(void);
+
+output_task_stats_t output_task_get_stats(void);
+void output_task_reset_stats(void);
+void output_task_print_stats(void);
+
+#endif
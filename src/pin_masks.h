@@ -0,0 +1,84 @@
+#ifndef _PIN_MASKS_H_
+#define _PIN_MASKS_H_
+
+#include <stdint.h>
+
+#include "pins.h"
+
+// -----------------------------------------------------------------------------
+// Nibble bzw. Tasten -> Pegel aller betroffenen Pins, zur Compile-Zeit aus
+// pins.h erzeugt
+//
+// Jeder Wechsel an D0..D3 oder den Triggern ist damit ein einziger
+// gpio_put_masked() (ein Zugriff auf SIO GPIO_OUT_XOR): alle Bits schalten
+// gleichzeitig, der Sampler sieht nie ein halb geschriebenes Nibble. Die
+// Tabellen gehen von den einzelnen Pin-Nummern aus und brauchen keine
+// aufeinanderfolgenden Pins (das verlangt nur die PIO).
+// -----------------------------------------------------------------------------
+
+struct pin_table_t {
+    uint32_t levels[16];
+};
+
+constexpr uint8_t msx_data_pin[4] = { PIN_MSX_D0, PIN_MSX_D1, PIN_MSX_D2, PIN_MSX_D3 };
+
+constexpr uint32_t MSX_DATA_MASK = (1u << PIN_MSX_D0) | (1u << PIN_MSX_D1) |
+                                   (1u << PIN_MSX_D2) | (1u << PIN_MSX_D3);
+constexpr uint32_t MSX_TRIG_MASK = (1u << PIN_MSX_TRIG_A) | (1u << PIN_MSX_TRIG_B);
+
+static_assert(__builtin_popcount(MSX_DATA_MASK) == 4, "D0..D3 brauchen vier verschiedene Pins");
+static_assert(!(MSX_DATA_MASK & MSX_TRIG_MASK), "Daten- und Trigger-Pins überschneiden sich");
+
+// Bit i des Nibbles -> Pegel an Di
+constexpr pin_table_t make_nibble_table()
+{
+    pin_table_t t = {};
+    for (uint32_t n = 0; n < 16; n++) {
+        for (uint32_t i = 0; i < 4; i++) {
+            if (n & (1u << i)) t.levels[n] |= 1u << msx_data_pin[i];
+        }
+    }
+    return t;
+}
+
+// Bit 0 Trigger A, Bit 1 Trigger B gedrückt -> Pegel (aktiv low)
+constexpr pin_table_t make_trigger_table()
+{
+    pin_table_t t = {};
+    for (uint32_t b = 0; b < 4; b++) {
+        t.levels[b] = MSX_TRIG_MASK;
+        if (b & 1) t.levels[b] &= ~(1u << PIN_MSX_TRIG_A);
+        if (b & 2) t.levels[b] &= ~(1u << PIN_MSX_TRIG_B);
+    }
+    return t;
+}
+
+inline constexpr pin_table_t msx_nibble_table  = make_nibble_table();
+inline constexpr pin_table_t msx_trigger_table = make_trigger_table();
+
+static_assert(msx_nibble_table.levels[15] == MSX_DATA_MASK, "Nibble-Tabelle unvollständig");
+static_assert(msx_trigger_table.levels[0] == MSX_TRIG_MASK, "Trigger sind aktiv low");
+
+// Pegel für gpio_put_masked(MSX_DATA_MASK, ...)
+static inline uint32_t msx_nibble_levels(uint8_t nibble)
+{
+    return msx_nibble_table.levels[nibble & 0x0F];
+}
+
+// Pegel für gpio_put_masked(MSX_TRIG_MASK, ...)
+static inline uint32_t msx_trigger_levels(uint8_t pressed)
+{
+    return msx_trigger_table.levels[pressed & 0x03];
+}
+
+// Rückweg (Host-Modell, Prüfungen): Pegel an D0..D3 als Nibble
+static inline uint8_t msx_levels_nibble(uint32_t levels)
+{
+    uint8_t n = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+        if (levels & (1u << msx_data_pin[i])) n |= (uint8_t)(1u << i);
+    }
+    return n;
+}
+
+#endif
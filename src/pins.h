@@ -0,0 +1,31 @@
+#ifndef _PINS_H_
+#define _PINS_H_
+
+// -----------------------------------------------------------------------------
+// Anschlussplan Pico <-> Roland S-750 Mausport (MSX-Belegung, DE-9)
+//
+//   DE-9 Pin 1  D0 (Up)      <- GP2
+//   DE-9 Pin 2  D1 (Down)    <- GP3
+//   DE-9 Pin 3  D2 (Left)    <- GP4
+//   DE-9 Pin 4  D3 (Right)   <- GP5
+//   DE-9 Pin 5  +5V          -> VSYS
+//   DE-9 Pin 6  Trigger A    <- GP6
+//   DE-9 Pin 7  Trigger B    <- GP7
+//   DE-9 Pin 8  Strobe       -> GP8  (5V! über Spannungsteiler auf 3,3V)
+//   DE-9 Pin 9  GND          -- GND
+//
+// D0..D3 müssen auf aufeinanderfolgenden GPIOs liegen (PIO "out pins, 4").
+// -----------------------------------------------------------------------------
+
+#define PIN_MSX_DATA_BASE   2   // D0, D1..D3 folgen
+#define PIN_MSX_TRIG_A      6
+#define PIN_MSX_TRIG_B      7
+#define PIN_MSX_STROBE      8
+
+// Einzelne Datenleitungen für die Pin-Tabellen (pin_masks.h)
+#define PIN_MSX_D0          (PIN_MSX_DATA_BASE + 0)
+#define PIN_MSX_D1          (PIN_MSX_DATA_BASE + 1)
+#define PIN_MSX_D2          (PIN_MSX_DATA_BASE + 2)
+#define PIN_MSX_D3          (PIN_MSX_DATA_BASE + 3)
+
+#endif
@@ -0,0 +1,56 @@
+#include "rate_meter.h"
+
+// Längste Lücke, die noch als verlorene Frames gilt (in bInterval)
+#ifndef ROLAND_RATE_GAP_FRAMES
+#define ROLAND_RATE_GAP_FRAMES 4
+#endif
+
+// Abstände darüber sind Pausen und gehen nicht in Rate/Jitter ein
+#ifndef ROLAND_RATE_PAUSE_US
+#define ROLAND_RATE_PAUSE_US 100000
+#endif
+
+#define EWMA_SHIFT 4
+
+void rate_meter_start(rate_meter_t* m, uint32_t expected_us)
+{
+    *m = rate_meter_t{};
+    m->expected_us = expected_us;
+}
+
+void rate_meter_note(rate_meter_t* m, uint32_t arrival_us, bool moving)
+{
+    uint32_t const iv = arrival_us - m->last_us;
+
+    if (moving && m->moving && iv <= ROLAND_RATE_PAUSE_US) {
+        int32_t const iv_q4 = (int32_t)(iv << 4);
+        if (!m->samples) m->mean_q4 = iv_q4;
+        else             m->mean_q4 += (iv_q4 - m->mean_q4) >> EWMA_SHIFT;
+
+        int32_t dev = iv_q4 - m->mean_q4;
+        if (dev < 0) dev = -dev;
+        m->jitter_q4 += (dev - m->jitter_q4) >> EWMA_SHIFT;
+
+        if (iv > m->max_us) m->max_us = iv;
+        m->samples++;
+
+        uint32_t const e = m->expected_us;
+        if (e && iv >= e + e / 2 && iv <= e * ROLAND_RATE_GAP_FRAMES + e / 2) {
+            m->gaps++;
+            m->missed += (iv + e / 2) / e - 1;
+        }
+    }
+
+    m->last_us = arrival_us;
+    m->moving  = moving;
+}
+
+uint32_t rate_meter_hz(rate_meter_t const* m)
+{
+    return m->mean_q4 > 0 ? (uint32_t)(16000000u / (uint32_t)m->mean_q4) : 0;
+}
+
+uint32_t rate_meter_jitter_us(rate_meter_t const* m)
+{
+    return (uint32_t)(m->jitter_q4 >> 4);
+}
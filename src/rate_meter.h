@@ -0,0 +1,41 @@
+#ifndef _RATE_METER_H_
+#define _RATE_METER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Report-Rate je HID-Instanz
+//
+// Gemessen wird der Abstand der Eingangszeiten aufeinanderfolgender Reports,
+// solange die Maus bewegt wird (mit SET_IDLE(0) sendet sie in Ruhe nichts).
+// Daraus ergeben sich gleitend Rate und Jitter (mittlere Abweichung vom
+// Mittelwert, Gewicht 1/16 je Abstand).
+//
+// Liegt ein Abstand bei mindestens 1,5 x bInterval, fehlen dazwischen Frames.
+// Nur Lücken bis ROLAND_RATE_GAP_FRAMES zählen als verloren; längere sind
+// Pausen der Bewegung. Sehr langsame Bewegung kann ebenfalls kurze Lücken
+// erzeugen, die Zahl ist daher eine Obergrenze.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t expected_us;   // aus bInterval; 0 = unbekannt, keine Lückenerkennung
+    uint32_t last_us;       // Eingang des letzten Reports
+    int32_t  mean_q4;       // gleitender Mittelwert des Abstands, µs * 16
+    int32_t  jitter_q4;     // gleitende mittlere Abweichung, µs * 16
+    uint32_t max_us;        // größter Abstand während Bewegung
+    uint32_t samples;       // gemessene Abstände
+    uint32_t gaps;          // Abstände mit fehlenden Frames
+    uint32_t missed;        // fehlende Frames insgesamt
+    bool     moving;        // letzter Report enthielt Bewegung
+} rate_meter_t;
+
+void rate_meter_start(rate_meter_t* m, uint32_t expected_us);
+
+// Je dekodiertem Mausreport; moving = Report enthält Bewegung
+void rate_meter_note(rate_meter_t* m, uint32_t arrival_us, bool moving);
+
+uint32_t rate_meter_hz(rate_meter_t const* m);
+uint32_t rate_meter_jitter_us(rate_meter_t const* m);
+
+#endif
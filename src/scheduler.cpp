@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/scb.h"
+#include "tusb.h"
+
+#include "scheduler.h"
+
+#ifndef ROLAND_LOOP_POLL
+#define ROLAND_LOOP_POLL 0
+#endif
+
+// Intervall der alten Poll-Schleife
+#ifndef ROLAND_LOOP_POLL_MS
+#define ROLAND_LOOP_POLL_MS 10
+#endif
+
+// Sicherheitsnetz im Event-Modus: tuh_task() läuft spätestens nach dieser
+// Zeit, auch wenn kein Interrupt kam. Nie seltener als die alte Schleife.
+#ifndef ROLAND_LOOP_IDLE_TIMEOUT_MS
+#define ROLAND_LOOP_IDLE_TIMEOUT_MS 10
+#endif
+
+static scheduler_stats_t stats;
+
+static uint32_t last_report_us;
+
+// Zeitpunkt, zu dem das anstehende USB-Event zuerst gesehen wurde
+static uint32_t ready_us;
+static bool     ready_valid;
+
+static inline void mark_ready(void)
+{
+    if (!ready_valid && tuh_task_event_ready()) {
+        ready_us    = time_us_32();
+        ready_valid = true;
+    }
+}
+
+void scheduler_init(void)
+{
+#if !ROLAND_LOOP_POLL
+    // Jeder neu anstehende Interrupt setzt das Event-Register. Damit wacht
+    // __wfe() auch dann sofort auf, wenn der Interrupt zwischen
+    // tuh_task_event_ready() und dem Schlafen eintraf.
+    scb_hw->scr |= M0PLUS_SCR_SEVONPEND_BITS;
+#endif
+    scheduler_reset_stats();
+}
+
+void scheduler_wait(void)
+{
+    uint64_t idle_start = time_us_64();
+
+#if ROLAND_LOOP_POLL
+    // Altes Verhalten: tuh_task() nur alle 10 ms. Geschlafen wird in
+    // 100-µs-Schritten, damit die Ankunft des Events messbar bleibt.
+    absolute_time_t deadline = make_timeout_time_ms(ROLAND_LOOP_POLL_MS);
+    while (!time_reached(deadline)) {
+        mark_ready();
+        sleep_us(100);
+    }
+#else
+    if (!tuh_task_event_ready()) {
+        best_effort_wfe_or_timeout(make_timeout_time_ms(ROLAND_LOOP_IDLE_TIMEOUT_MS));
+    }
+#endif
+    stats.idle_us += time_us_64() - idle_start;
+    stats.wakeups++;
+    mark_ready();
+}
+
+void scheduler_task_done(void)
+{
+    ready_valid = false;
+}
+
+void scheduler_note_report(void)
+{
+    stats.reports++;
+    last_report_us = time_us_32();
+    if (!ready_valid) return;
+
+    uint32_t lat = time_us_32() - ready_us;
+    if (lat < stats.latency_min_us) stats.latency_min_us = lat;
+    if (lat > stats.latency_max_us) stats.latency_max_us = lat;
+    stats.latency_sum_us += lat;
+    stats.latency_samples++;
+}
+
+uint32_t scheduler_last_report_us(void)
+{
+    return last_report_us;
+}
+
+scheduler_stats_t scheduler_get_stats(void)
+{
+    return stats;
+}
+
+void scheduler_reset_stats(void)
+{
+    stats = scheduler_stats_t{};
+    stats.latency_min_us  = UINT32_MAX;
+    stats.window_start_us = time_us_64();
+}
+
+void scheduler_print_stats(void)
+{
+    uint64_t window_us = time_us_64() - stats.window_start_us;
+    uint32_t rate_hz   = window_us ? (uint32_t)((uint64_t)stats.reports * 1000000u / window_us) : 0;
+    uint32_t load_pct  = window_us ? (uint32_t)(100u - stats.idle_us * 100u / window_us) : 0;
+    uint32_t avg_us    = stats.latency_samples ? (uint32_t)(stats.latency_sum_us / stats.latency_samples) : 0;
+
+    printf("Loop[%s]: load=%lu%%, wakeups=%lu, reports=%lu, rate=%lu Hz, latency min/avg/max=%lu/%lu/%lu us\n",
+           ROLAND_LOOP_POLL ? "poll" : "event", (unsigned long)load_pct,
+           (unsigned long)stats.wakeups, (unsigned long)stats.reports,
+           (unsigned long)rate_hz,
+           (unsigned long)(stats.latency_samples ? stats.latency_min_us : 0),
+           (unsigned long)avg_us, (unsigned long)stats.latency_max_us);
+}
@@ -0,0 +1,44 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Hauptschleifen-Scheduler
+//
+// Standard: ereignisgesteuert. Die Schleife schläft per WFE, bis ein
+// Interrupt (USB-Host, Timer, ...) anliegt, und ruft tuh_task() sofort auf.
+// Mit ROLAND_LOOP_POLL=1 wird zum Vergleich die alte feste
+// sleep_ms(10)-Schleife gebaut.
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t wakeups;         // Schleifendurchläufe
+    uint32_t reports;         // empfangene HID-Reports
+    uint32_t latency_samples; // Reports mit gültigem Bereit-Zeitstempel
+    uint32_t latency_min_us;  // Event bereit -> Report verarbeitet
+    uint32_t latency_max_us;
+    uint64_t latency_sum_us;
+    uint64_t idle_us;         // Core0: Zeit in scheduler_wait()
+    uint64_t window_start_us; // Beginn des Messfensters
+} scheduler_stats_t;
+
+void scheduler_init(void);
+
+// Blockiert, bis USB-Host-Arbeit ansteht (oder das Sicherheits-Timeout abläuft)
+void scheduler_wait(void);
+
+// Nach tuh_task() aufrufen: Messung für diesen Durchlauf abschließen
+void scheduler_task_done(void);
+
+// Aus tuh_hid_report_received_cb aufrufen
+void scheduler_note_report(void);
+
+// Eingang des letzten Reports (time_us_32)
+uint32_t scheduler_last_report_us(void);
+
+scheduler_stats_t scheduler_get_stats(void);
+void scheduler_reset_stats(void);
+void scheduler_print_stats(void);
+
+#endif
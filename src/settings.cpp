@@ -0,0 +1,292 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "tusb.h"
+
+#include "ballistics.h"
+#include "output_backend.h"
+#include "output_task.h"
+#include "scheduler.h"
+#include "settings.h"
+
+// Werte müssen so lange unverändert sein, bevor sie geschrieben werden
+#ifndef ROLAND_SETTINGS_SAVE_DELAY_MS
+#define ROLAND_SETTINGS_SAVE_DELAY_MS 2000
+#endif
+
+// So lange darf kein Report gekommen sein (Maus in Ruhe)
+#ifndef ROLAND_SETTINGS_QUIET_MS
+#define ROLAND_SETTINGS_QUIET_MS 500
+#endif
+
+// Beim Laden höchstens so viele Sätze vor dem Ende auf gültige CRC prüfen
+#ifndef ROLAND_SETTINGS_SCAN
+#define ROLAND_SETTINGS_SCAN 4
+#endif
+
+#define SETTINGS_MAGIC   0x5E77
+#define SETTINGS_VERSION 1
+
+typedef struct {
+    uint16_t magic;
+    uint8_t  version;
+    uint8_t  reserved0;
+    uint32_t seq;
+    uint16_t scale_pct;
+    uint8_t  profile;
+    uint8_t  invert;
+    uint8_t  backend;
+    uint8_t  reserved[15];
+    uint32_t crc;          // CRC-32 über alles davor
+} record_t;
+
+#define SLOTS  (FLASH_SECTOR_SIZE / sizeof(record_t))
+#define REGION (PICO_FLASH_SIZE_BYTES - ROLAND_SETTINGS_SECTORS * FLASH_SECTOR_SIZE)
+
+static_assert(sizeof(record_t) == SETTINGS_RECORD_SIZE, "Satz = 32 Byte");
+static_assert(FLASH_PAGE_SIZE % sizeof(record_t) == 0, "Sätze dürfen keine Seitengrenze kreuzen");
+static_assert(SLOTS <= 255, "slot passt in uint8_t");
+static_assert(ROLAND_SETTINGS_SECTORS >= 2 && ROLAND_SETTINGS_SECTORS <= 64, "2..64 Sektoren");
+
+static settings_stats_t stats;
+
+static settings_t saved;              // Stand des letzten gültigen Satzes
+static settings_t pending;            // zuletzt gesehener Stand
+static uint32_t   pending_since_us;
+
+static uint8_t page[FLASH_PAGE_SIZE];
+
+static record_t const* record_at(uint32_t sector, uint32_t slot)
+{
+    return (record_t const*)(XIP_BASE + REGION + sector * FLASH_SECTOR_SIZE + slot * sizeof(record_t));
+}
+
+// Zugriff beim Laden, gezählt
+static record_t const* probe(uint32_t sector, uint32_t slot)
+{
+    stats.load_reads++;
+    return record_at(sector, slot);
+}
+
+static uint32_t crc32(uint8_t const* p, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static bool record_valid(record_t const* r)
+{
+    return r->magic == SETTINGS_MAGIC && r->version == SETTINGS_VERSION &&
+           r->crc == crc32((uint8_t const*)r, offsetof(record_t, crc));
+}
+
+static bool record_erased(record_t const* r)
+{
+    uint32_t const* w = (uint32_t const*)r;
+    for (size_t i = 0; i < sizeof(record_t) / 4; i++) {
+        if (w[i] != 0xFFFFFFFFu) return false;
+    }
+    return true;
+}
+
+static bool same(settings_t const& a, settings_t const& b)
+{
+    return a.scale_pct == b.scale_pct && a.profile == b.profile &&
+           a.invert == b.invert && a.backend == b.backend;
+}
+
+// -----------------------------------------------------------------------------
+// Laden
+// -----------------------------------------------------------------------------
+
+// Sätze werden nur hinten angehängt: belegt ist ein Präfix des Sektors.
+// Satz 0 ist gültig; liefert den neuesten gültigen Satz, spätestens Satz 0.
+static record_t const* newest_in(uint32_t sector, uint32_t* end)
+{
+    uint32_t lo = 1;
+    uint32_t hi = SLOTS;   // erster freier Satz liegt in [lo, hi]
+    while (lo < hi) {
+        uint32_t const mid = (lo + hi) / 2;
+        if (record_erased(probe(sector, mid))) hi = mid;
+        else lo = mid + 1;
+    }
+    *end = lo;
+
+    // Abgerissene Schreibvorgänge am Ende überspringen
+    for (uint32_t n = 1; n <= ROLAND_SETTINGS_SCAN && n < lo; n++) {
+        record_t const* r = probe(sector, lo - n);
+        if (record_valid(r)) return r;
+    }
+    return record_at(sector, 0);
+}
+
+static record_t const* load(void)
+{
+    int32_t  best     = -1;
+    uint32_t best_seq = 0;
+    for (uint32_t s = 0; s < ROLAND_SETTINGS_SECTORS; s++) {
+        record_t const* r = probe(s, 0);
+        if (record_valid(r) && r->seq > best_seq) {
+            best     = (int32_t)s;
+            best_seq = r->seq;
+        }
+    }
+
+    if (best < 0) {
+        // Leer oder fremder Inhalt: der erste Satz löscht Sektor 0
+        stats.sector = ROLAND_SETTINGS_SECTORS - 1;
+        stats.slot   = SLOTS;
+        stats.seq    = 0;
+        return nullptr;
+    }
+
+    uint32_t end;
+    record_t const* r = newest_in((uint32_t)best, &end);
+    stats.sector = (uint8_t)best;
+    stats.slot   = (uint8_t)end;
+    stats.seq    = r->seq;
+    return r;
+}
+
+static void apply(record_t const* r)
+{
+    if (r->profile < BALLISTICS_PROFILE_COUNT) ballistics_set_profile((ballistics_profile_t)r->profile);
+    ballistics_set_scale(r->scale_pct);
+    ballistics_set_invert(r->invert);
+    // Mit festem Protokoll (ROLAND_OUTPUT_RUNTIME=0) wirkungslos
+    if (r->backend < OUTPUT_BACKEND_COUNT && r->backend != output_task_backend()) {
+        output_task_select(r->backend);
+    }
+}
+
+void settings_init(void)
+{
+    uint32_t const t0 = time_us_32();
+    stats.load_reads = 0;
+    record_t const* r = load();
+    if (r) apply(r);
+    stats.load_us = time_us_32() - t0;
+
+    saved            = settings_current();
+    pending          = saved;
+    pending_since_us = time_us_32();
+}
+
+// -----------------------------------------------------------------------------
+// Schreiben
+// -----------------------------------------------------------------------------
+
+static void erase_op(void* param)
+{
+    flash_range_erase((uint32_t)(uintptr_t)param, FLASH_SECTOR_SIZE);
+}
+
+static void program_op(void* param)
+{
+    flash_range_program((uint32_t)(uintptr_t)param, page, FLASH_PAGE_SIZE);
+}
+
+static void erase_next(void)
+{
+    uint32_t const next = (stats.sector + 1u) % ROLAND_SETTINGS_SECTORS;
+    uint32_t const offs = REGION + next * FLASH_SECTOR_SIZE;
+    if (flash_safe_execute(erase_op, (void*)(uintptr_t)offs, 10) != PICO_OK) return;
+
+    stats.sector = (uint8_t)next;
+    stats.slot   = 0;
+    stats.erases++;
+}
+
+static void append(settings_t const& s)
+{
+    record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.magic     = SETTINGS_MAGIC;
+    rec.version   = SETTINGS_VERSION;
+    rec.seq       = stats.seq + 1;
+    rec.scale_pct = s.scale_pct;
+    rec.profile   = s.profile;
+    rec.invert    = s.invert;
+    rec.backend   = s.backend;
+    rec.crc       = crc32((uint8_t const*)&rec, offsetof(record_t, crc));
+
+    // Ganze Seite programmieren, außerhalb des Satzes 0xFF (lässt Bits stehen)
+    uint32_t const pos  = stats.slot * sizeof(record_t);
+    uint32_t const offs = REGION + stats.sector * FLASH_SECTOR_SIZE + (pos & ~(FLASH_PAGE_SIZE - 1));
+    memset(page, 0xFF, sizeof(page));
+    memcpy(&page[pos & (FLASH_PAGE_SIZE - 1)], &rec, sizeof(rec));
+    if (flash_safe_execute(program_op, (void*)(uintptr_t)offs, 10) != PICO_OK) return;
+
+    // Fehlschlag: der nächste Versuch kommt nach erneuter Wartezeit. Ein
+    // teilweise geschriebener Satz bleibt liegen und der Versuch nimmt den
+    // folgenden; ein unberührter wird wiederverwendet, damit belegt ein
+    // Präfix bleibt. Satz 0 muss gültig sein, sonst übersieht das Laden den
+    // ganzen Sektor: dann den Sektor neu löschen (erase_next vom vorigen aus).
+    record_t const* r = record_at(stats.sector, stats.slot);
+    if (!record_valid(r)) {
+        stats.failed++;
+        pending_since_us = time_us_32();
+        if (stats.slot == 0) {
+            stats.sector = (uint8_t)((stats.sector + ROLAND_SETTINGS_SECTORS - 1) % ROLAND_SETTINGS_SECTORS);
+            stats.slot   = SLOTS;
+        } else if (!record_erased(r)) {
+            stats.slot++;
+        }
+        return;
+    }
+    stats.slot++;
+    stats.seq = rec.seq;
+    stats.writes++;
+    saved = s;
+}
+
+void settings_service(void)
+{
+    settings_t const cur = settings_current();
+    uint32_t const now = time_us_32();
+    if (!same(cur, pending)) {
+        pending          = cur;
+        pending_since_us = now;
+    }
+    if (same(pending, saved)) return;
+
+    // Flash sperrt Interrupts für Millisekunden: nur in echter Ruhe
+    if (now - pending_since_us < ROLAND_SETTINGS_SAVE_DELAY_MS * 1000u) return;
+    if (now - scheduler_last_report_us() < ROLAND_SETTINGS_QUIET_MS * 1000u) return;
+    if (tuh_task_event_ready()) return;
+
+    // Ein Vorgang je Aufruf: Löschen und Schreiben in getrennten Durchläufen
+    if (stats.slot >= SLOTS) erase_next();
+    else append(pending);
+}
+
+settings_t settings_current(void)
+{
+    settings_t s;
+    s.scale_pct = ballistics_scale();
+    s.profile   = (uint8_t)ballistics_profile();
+    s.invert    = ballistics_invert();
+    s.backend   = output_task_backend();
+    return s;
+}
+
+settings_stats_t settings_get_stats(void)
+{
+    return stats;
+}
+
+void settings_print(void)
+{
+    printf("Settings: seq=%lu, sector=%u/%u, slot=%u/%u, writes=%lu, erases=%lu, failed=%lu, load=%lu us (%u reads)%s\n",
+           (unsigned long)stats.seq, stats.sector, (unsigned)ROLAND_SETTINGS_SECTORS,
+           stats.slot, (unsigned)SLOTS, (unsigned long)stats.writes, (unsigned long)stats.erases,
+           (unsigned long)stats.failed, (unsigned long)stats.load_us, stats.load_reads,
+           same(pending, saved) ? "" : ", unsaved");
+}
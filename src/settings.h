@@ -0,0 +1,62 @@
+#ifndef _SETTINGS_H_
+#define _SETTINGS_H_
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Einstellungen im Flash
+//
+// Die letzten ROLAND_SETTINGS_SECTORS Sektoren sind ein Log aus 32-Byte-
+// Sätzen mit fortlaufender Nummer und CRC-32. Jede Änderung hängt einen Satz
+// an; gelöscht wird nur, wenn ein Sektor voll ist, und zwar der nächste im
+// Ring. Beim Start entscheidet Satz 0 jedes Sektors, welcher der neueste ist,
+// darin findet eine binäre Suche das Ende; von dort werden höchstens
+// ROLAND_SETTINGS_SCAN Sätze rückwärts auf eine gültige CRC geprüft. Die
+// Zahl der Flash-Zugriffe ist damit unabhängig vom Füllstand. Deshalb folgt
+// auf Satz 0 eines Sektors erst dann ein weiterer, wenn er gültig gelesen
+// wurde; sonst wird der Sektor neu gelöscht.
+//
+// Geschrieben wird nur aus settings_service() in der Leerlaufarbeit der
+// Hauptschleife: höchstens ein Flash-Vorgang je Aufruf, und erst wenn die
+// Werte eine Weile stehen, keine USB-Arbeit ansteht und seit einiger Zeit
+// kein Report kam. Während des Vorgangs sind Interrupts gesperrt und der
+// andere Core angehalten (flash_safe_execute).
+// -----------------------------------------------------------------------------
+
+// Sektoren am Ende des Flash; mindestens zwei, damit beim Löschen immer ein
+// gültiger Satz erhalten bleibt
+#ifndef ROLAND_SETTINGS_SECTORS
+#define ROLAND_SETTINGS_SECTORS 2
+#endif
+
+#define SETTINGS_RECORD_SIZE 32
+
+typedef struct {
+    uint16_t scale_pct;   // ballistics_scale()
+    uint8_t  profile;     // ballistics_profile_t
+    uint8_t  invert;      // BALLISTICS_INVERT_*
+    uint8_t  backend;     // output_backend_id_t
+} settings_t;
+
+typedef struct {
+    uint32_t seq;           // Nummer des zuletzt gültigen Satzes (0 = keiner)
+    uint8_t  sector;        // aktiver Sektor im Log
+    uint8_t  slot;          // nächster freier Satz darin
+    uint8_t  load_reads;    // Satzzugriffe beim Laden
+    uint32_t load_us;       // Dauer des Ladens
+    uint32_t writes;
+    uint32_t erases;
+    uint32_t failed;        // Satz nach dem Schreiben ungültig
+} settings_stats_t;
+
+// Neuesten Satz laden und anwenden; nach output_task_start() aufrufen
+void settings_init(void);
+
+// Leerlaufarbeit der Hauptschleife: Änderungen erkennen und verzögert speichern
+void settings_service(void);
+
+settings_t settings_current(void);
+settings_stats_t settings_get_stats(void);
+void settings_print(void);
+
+#endif
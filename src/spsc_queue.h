@@ -0,0 +1,63 @@
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <stdint.h>
+#include <atomic>
+
+// -----------------------------------------------------------------------------
+// Lock-freie Single-Producer/Single-Consumer-Queue fester Größe
+//
+// Genau ein Kontext ruft push(), genau einer pop() (z. B. Core0 -> Core1).
+// Es werden nur atomare Loads/Stores benutzt; der Cortex-M0+ hat keine
+// Read-Modify-Write-Befehle, daher kommt die Queue ohne Spinlocks aus.
+// -----------------------------------------------------------------------------
+
+template <typename T, uint32_t N>
+class SpscQueue {
+    static_assert(N && (N & (N - 1)) == 0, "N muss eine Zweierpotenz sein");
+
+public:
+    bool push(T const& v)
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail == N) return false;
+
+        buf_[head & (N - 1)] = v;
+        head_.store(head + 1, std::memory_order_release);
+
+        uint32_t fill = head + 1 - tail;
+        if (fill > high_water_) high_water_ = fill;
+        return true;
+    }
+
+    bool pop(T& v)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) return false;
+
+        v = buf_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    // Höchster beobachteter Füllstand (vom Producer gepflegt)
+    uint32_t high_water() const { return high_water_; }
+    void reset_high_water() { high_water_ = 0; }
+
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    std::atomic<uint32_t> head_{0};   // nur Producer schreibt
+    std::atomic<uint32_t> tail_{0};   // nur Consumer schreibt
+    uint32_t high_water_ = 0;
+    T buf_[N];
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+
+#include "trace.h"
+
+#ifndef ROLAND_TRACE_SIZE
+#define ROLAND_TRACE_SIZE 256   // Einträge, Zweierpotenz
+#endif
+
+#ifndef ROLAND_TRACE_LIVE
+#define ROLAND_TRACE_LIVE 1
+#endif
+
+static_assert((ROLAND_TRACE_SIZE & (ROLAND_TRACE_SIZE - 1)) == 0, "ROLAND_TRACE_SIZE muss eine Zweierpotenz sein");
+static_assert(sizeof(trace_record_t) == 16, "trace_record_t soll 16 Byte groß bleiben");
+
+// Schreiber und Leser laufen beide auf Core0 (tuh_task bzw. Hauptschleife)
+static trace_record_t ring[ROLAND_TRACE_SIZE];
+static uint32_t head;
+static uint32_t tail;
+static uint32_t dropped;
+static bool     live = ROLAND_TRACE_LIVE;
+
+// Längste Zeile 71 Zeichen samt '\n':
+// "4294967295 mouse  255/255 buttons=ff, x=-32768, y=-32768, wheel=-32768\n"
+#define TRACE_LINE_MAX 80
+
+// Zeile, die trace_service() gerade Zeichen für Zeichen sendet
+static char    line[TRACE_LINE_MAX];
+static uint8_t line_len;
+static uint8_t line_pos;
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v >  INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+static inline trace_record_t* trace_alloc(void)
+{
+    if (head - tail == ROLAND_TRACE_SIZE) {
+        tail++;   // ältesten Eintrag opfern
+        dropped++;
+    }
+    return &ring[head++ & (ROLAND_TRACE_SIZE - 1)];
+}
+
+void trace_report(uint8_t dev_addr, uint8_t instance, hid_mouse_sample_t const* sample, uint32_t arrival_us)
+{
+    trace_record_t* r = trace_alloc();
+    r->t_us     = arrival_us;
+    r->type     = TRACE_REPORT;
+    r->dev_addr = dev_addr;
+    r->instance = instance;
+    r->buttons  = sample->buttons;
+    r->x        = sat16(sample->x);
+    r->y        = sat16(sample->y);
+    r->wheel    = sat16(sample->wheel);
+}
+
+void trace_event(uint8_t type, uint8_t dev_addr, uint8_t instance)
+{
+    trace_record_t* r = trace_alloc();
+    *r = trace_record_t{};
+    r->t_us     = time_us_32();
+    r->type     = type;
+    r->dev_addr = dev_addr;
+    r->instance = instance;
+}
+
+static int format_record(char* buf, size_t size, trace_record_t const* r)
+{
+    switch (r->type) {
+    case TRACE_MOUNT:
+        return snprintf(buf, size, "%10lu mount  %u/%u\n",
+                        (unsigned long)r->t_us, r->dev_addr, r->instance);
+    case TRACE_UMOUNT:
+        return snprintf(buf, size, "%10lu umount %u/%u\n",
+                        (unsigned long)r->t_us, r->dev_addr, r->instance);
+    default:
+        return snprintf(buf, size, "%10lu mouse  %u/%u buttons=%02x, x=%d, y=%d, wheel=%d\n",
+                        (unsigned long)r->t_us, r->dev_addr, r->instance,
+                        r->buttons, r->x, r->y, r->wheel);
+    }
+}
+
+// Länge der Zeile in buf (size = TRACE_LINE_MAX); gekürzt endet sie trotzdem
+// mit '\n', damit Einträge nicht zusammenkleben
+static int format(char* buf, size_t size, trace_record_t const* r)
+{
+    int const n = format_record(buf, size, r);
+    if (n < (int)size) return n;
+    buf[size - 2] = '\n';
+    return (int)size - 1;
+}
+
+void trace_set_live(bool on)
+{
+    live = on;
+}
+
+bool trace_live(void)
+{
+    return live;
+}
+
+void trace_service(void)
+{
+    uart_inst_t* uart = uart_get_instance(PICO_DEFAULT_UART);
+
+    while (true) {
+        if (line_pos == line_len) {
+            if (!live || head == tail) return;
+            line_len = (uint8_t)format(line, sizeof(line), &ring[tail++ & (ROLAND_TRACE_SIZE - 1)]);
+            line_pos = 0;
+        }
+        while (line_pos < line_len) {
+            if (!uart_is_writable(uart)) return;
+            uart_putc_raw(uart, line[line_pos++]);
+        }
+    }
+}
+
+void trace_dump(void)
+{
+    char buf[TRACE_LINE_MAX];
+    printf("Trace: %lu entries, %lu dropped\n",
+           (unsigned long)(head - tail), (unsigned long)dropped);
+    while (head != tail) {
+        format(buf, sizeof(buf), &ring[tail++ & (ROLAND_TRACE_SIZE - 1)]);
+        fputs(buf, stdout);
+    }
+}
+
+uint32_t trace_dropped(void)
+{
+    return dropped;
+}
@@ -0,0 +1,53 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hid_layout.h"
+
+// -----------------------------------------------------------------------------
+// Binärer Trace-Ring
+//
+// Der Report-Callback legt nur einen festen 16-Byte-Eintrag ab; formatiert
+// und gesendet wird später in der Hauptschleife (trace_service, nicht
+// blockierend) oder auf Kommando (trace_dump). Ist der Ring voll, wird der
+// älteste Eintrag überschrieben und als verloren gezählt.
+// -----------------------------------------------------------------------------
+
+enum {
+    TRACE_REPORT = 0,
+    TRACE_MOUNT,
+    TRACE_UMOUNT,
+};
+
+typedef struct {
+    uint32_t t_us;       // Reports: Eingang im Callback, sonst Zeitpunkt des Ereignisses
+    uint8_t  type;
+    uint8_t  dev_addr;
+    uint8_t  instance;
+    uint8_t  buttons;
+    int16_t  x;
+    int16_t  y;
+    int16_t  wheel;
+    uint16_t reserved;
+} trace_record_t;
+
+// arrival_us = Eingang des Reports (hid_reports), nicht der Verarbeitung
+void trace_report(uint8_t dev_addr, uint8_t instance, hid_mouse_sample_t const* sample, uint32_t arrival_us);
+void trace_event(uint8_t type, uint8_t dev_addr, uint8_t instance);
+
+// Live-Ausgabe: Einträge laufend über die UART senden
+void trace_set_live(bool live);
+bool trace_live(void);
+
+// Aus der Hauptschleife: höchstens so viele Zeichen senden, wie der
+// UART-FIFO gerade aufnimmt
+void trace_service(void);
+
+// Alle gepufferten Einträge ausgeben (blockierend, nur auf Kommando)
+void trace_dump(void);
+
+uint32_t trace_dropped(void);
+
+#endif
@@ -11,6 +11,7 @@
 #define BOARD_TUH_RHPORT          0
 
 #define CFG_TUH_HUB               1
+#define CFG_TUH_HID               4   // HID-Instanzen gesamt (Host-Klasse aktiv)
 #define CFG_TUH_HID_MOUSE         1
 #define CFG_TUH_HID_KEYBOARD      0
 #define CFG_TUH_HID_GENERIC       0